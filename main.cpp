@@ -1,4 +1,5 @@
 #include <iostream>
+#include <sstream>
 
 #include "sgl/sgl.hpp"
 
@@ -32,6 +33,26 @@ int main(int argc, char *argv[]) {
     using VEF = sgl::VectorEdgeVertex<char, sgl::VisitIntIDFlag, FE>;
     using DFG = sgl::RandomAccessEdgeGraph<VEF, FE, true>;
 
+    using CV = sgl::CompressedVertex<char, sgl::APCFlag<char, ES>, ES>;
+    using CSG = sgl::CompressedSparseGraph<CV, ES, false>;
+    using DCSG = sgl::CompressedSparseGraph<CV, ES, true>;
+    using LE = sgl::Edge<size_t, int>;
+    using LCSG = sgl::CompressedSparseGraph<sgl::CompressedVertex<char, sgl::APCFlag<char, LE>, LE>, LE, false>;
+    using XV = sgl::IndexedEdgeVertex<char, sgl::APIFlag<char, EI>, EI>;
+    using XG = sgl::IndexedEdgeGraph<XV, EI, false>;
+    using DXG = sgl::IndexedEdgeGraph<XV, EI, true>;
+    using PV = sgl::IndexedEdgeVertex<std::pair<int, int>, sgl::APIFlag<std::pair<int, int>, EI>, EI>;
+    using PG = sgl::IndexedEdgeGraph<PV, EI, false>;
+
+    using IV = sgl::VectorVertex<char, sgl::IDFlag<int>>;
+    using IRAG = sgl::RandomAccessGraph<IV, false>;
+
+    using EV = sgl::VectorVertex<char, sgl::EpochVisitIntIDFlag>;
+    using EDAG = sgl::RandomAccessGraph<EV, true>;
+
+    using AV = sgl::VectorVertex<char, sgl::APFlag<char, sgl::ArenaAllocator<void>>, sgl::ArenaAllocator<void>>;
+    using AAPG = sgl::RandomAccessGraph<AV, false, sgl::ArenaAllocator<AV>>;
+
     static_assert(sgl::VertexVisit<VV>);
     static_assert(sgl::VertexID<VV>);
     //static_assert(sgl::VertexDirected<DV>);
@@ -49,6 +70,26 @@ int main(int argc, char *argv[]) {
 
     static_assert(sgl::EdgeFlow<FE>);
 
+    static_assert(sgl::VertexEdge<CV>);
+    static_assert(sgl::GraphID<DCSG>);
+    static_assert(sgl::GraphEdge<DCSG>);
+    static_assert(sgl::GraphRandomlyAccessible<DCSG>);
+    static_assert(sgl::GraphUndirected<CSG>);
+
+    static_assert(sgl::PropertyMapVisit<sgl::BitsetVisitMap>);
+    static_assert(sgl::IsPropertyMap<sgl::VectorPropertyMap<int>>);
+    static_assert(sgl::GraphID<IRAG>);
+    static_assert(!sgl::GraphVisit<IRAG>);
+
+    static_assert(sgl::FlagEpoch<sgl::EpochVisitIntIDFlag>);
+    static_assert(sgl::GraphVisit<EDAG>);
+    static_assert(sgl::PropertyMapVisit<sgl::EpochVisitMap>);
+
+    static_assert(sgl::GraphAP<AAPG>);
+    static_assert(sgl::VertexArc<XV>);
+    static_assert(!sgl::VertexArc<VEV>);
+    static_assert(sizeof(XV::ArcType) == 2 * sizeof(int));
+
     std::cout << "Test of deepFirstSearch() with VectorVertex and RandomAccessGraph" << std::endl;
 
     size_t correctCount = 0;
@@ -64,7 +105,8 @@ int main(int argc, char *argv[]) {
     rag.addVertices(std::begin(letters), std::end(letters));
     rag.addEdges(letterEdges.begin(), letterEdges.end());
     sgl::deepFirstSearch(rag, [&lri, &correctCount](VV& v) {
-        if (*lri == v.data) ++correctCount; ++lri;
+        if (*lri == v.data) ++correctCount;
+        ++lri;
         }, [](VV& v){});
     printResult(correctCount == 8);
 
@@ -76,7 +118,8 @@ int main(int argc, char *argv[]) {
     lri = bfsLettersResult.begin();
 
     sgl::breadthFirstSearch(rag, [&lri, &correctCount](VV& v) {
-        if (*lri == v.data) ++correctCount; ++lri;
+        if (*lri == v.data) ++correctCount;
+        ++lri;
     }, [](VV& v) {});
 
     printResult(correctCount == 8);
@@ -136,7 +179,7 @@ int main(int argc, char *argv[]) {
             {0, 1, {10}}, {0, 3, {5}}, {1, 2, {1}}, {1, 3, {2}}, {2, 4, {4}},
             {3, 1, {3}}, {3, 2, {9}}, {3, 4, {2}}, {4, 0, {7}}, {4, 2, {6}}
     };
-    std::vector<int> dijCorrect = {0, 8, 9, 5, 7};
+    std::vector<size_t> dijCorrect = {0, 8, 9, 5, 7};
     size_t i = 0;
 
     DRAEG draeg = {};
@@ -162,7 +205,7 @@ int main(int argc, char *argv[]) {
             {3, 4, 9}, {3, 5, 14}, {4, 5, 10}, {5, 6,  2}, {6, 7, 1}, {6, 8, 6}, {7, 8, 7}
     };
     std::vector<ES*> primResult = {};
-    std::vector<std::pair<int, int>> primCorrect = {
+    std::vector<std::pair<size_t, size_t>> primCorrect = {
             {0, 1}, {0, 7}, {6, 7}, {5, 6}, {2, 5}, {2, 8}, {2, 3}, {3, 4}
     };
     auto primIt = primCorrect.begin();
@@ -221,5 +264,1166 @@ int main(int argc, char *argv[]) {
 
     printResult(flow == 5);
 
+    std::cout << "Test of CompressedSparseGraph with dijkstra(), prim() and floydWarshall()" << std::endl;
+    correctCount = 0;
+
+    DCSG dcsg(draeg);
+    sgl::dijkstra(dcsg, dcsg[0]);
+
+    for (i = 0; i < dcsg.vertexCount(); ++i) {
+        if (dcsg[i].flags.dist == dijCorrect[i]) {
+            correctCount++;
+        }
+    }
+
+    auto csrFwResult = sgl::floydWarshall(dcsg);
+
+    for (i = 0; i < csrFwResult.size(); ++i) {
+        for (size_t j = 0; j < csrFwResult[i].size(); ++j) {
+            if (std::get<0>(csrFwResult[i][j]) == fwCorrect[i][j]) {
+                correctCount++;
+            }
+        }
+    }
+
+    CSG csg(primChars.begin(), primChars.end(), primTups.begin(), primTups.end());
+    std::vector<ES*> csrPrimResult = {};
+    sgl::prim(csg, csrPrimResult);
+
+    primIt = primCorrect.begin();
+    for (auto e: csrPrimResult) {
+        if (e->from() == std::get<0>(*primIt) && e->to() == std::get<1>(*primIt)) {
+            correctCount++;
+        }
+        ++primIt;
+    }
+
+    CSG grownCsg(csg);
+    grownCsg.addVertex(grownCsg[0]);
+    if (grownCsg.vertexCount() == primChars.size() + 1 && grownCsg[primChars.size()].flags.id == primChars.size() &&
+        grownCsg.degree(primChars.size()) == 0 && grownCsg[0].flags.id == 0) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 5 + 25 + 8 + 1);
+
+    std::cout << "Test of deepFirstSearch(), breadthFirstSearch() and dijkstra() with property maps" << std::endl;
+    correctCount = 0;
+
+    IRAG irag = {};
+    irag.addVertices(std::begin(letters), std::end(letters));
+    irag.addEdges(letterEdges.begin(), letterEdges.end());
+    sgl::BitsetVisitMap visitMap(irag.vertexCount());
+
+    lri = letterResult.begin();
+    sgl::deepFirstSearch(irag, visitMap, [&lri, &correctCount](IV& v) {
+        if (*lri == v.data) ++correctCount;
+        ++lri;
+    }, [](IV& v) {});
+
+    visitMap.reset();
+    lri = bfsLettersResult.begin();
+    sgl::breadthFirstSearch(irag, visitMap, [&lri, &correctCount](IV& v) {
+        if (*lri == v.data) ++correctCount;
+        ++lri;
+    }, [](IV& v) {});
+
+    sgl::VectorPropertyMap<int> distMap(draeg.vertexCount());
+    sgl::VectorPropertyMap<size_t> prevMap(draeg.vertexCount());
+    sgl::dijkstra(draeg, draeg[0], distMap, prevMap);
+
+    for (i = 0; i < distMap.size(); ++i) {
+        if (static_cast<size_t>(distMap[i]) == dijCorrect[i]) {
+            correctCount++;
+        }
+    }
+
+    printResult(correctCount == 8 + 8 + 5 && prevMap[0] == sgl::invalidID<size_t>() && prevMap[2] == 1);
+
+    std::cout << "Test of EpochVisitIntIDFlag and EpochVisitMap" << std::endl;
+    correctCount = 0;
+
+    EDAG edag = {};
+    edag.addVertices(letters.begin(), letters.end());
+    edag.addEdges(dagEdges.begin(), dagEdges.end());
+
+    for (int round = 0; round < 2; ++round) {
+        auto epochScc = sgl::stronglyConnectedComponents(edag);
+        edag.reset();
+
+        for (size_t k = 0; k < epochScc.size(); ++k) {
+            for (size_t j = 0; j < epochScc[k].size(); ++j) {
+                if (epochScc[k][j] == sccCorrect[k][j]) {
+                    correctCount++;
+                }
+            }
+        }
+    }
+
+    sgl::EpochVisitMap epochMap(irag.vertexCount());
+    size_t epochVisits = 0;
+    for (int round = 0; round < 3; ++round) {
+        sgl::breadthFirstSearch(irag, epochMap, [&epochVisits](IV& v) { ++epochVisits; }, [](IV& v) {});
+        epochMap.reset();
+    }
+
+    // Each graph owns its epoch, so resetting one leaves the other's visited state alone.
+    EDAG otherEdag = {};
+    otherEdag.addVertices(letters.begin(), letters.end());
+    otherEdag.addEdges(dagEdges.begin(), dagEdges.end());
+    for (int round = 0; round < 3; ++round) {
+        EDAG& visitedGraph = round % 2 == 0 ? edag : otherEdag;
+        EDAG& resetGraph = round % 2 == 0 ? otherEdag : edag;
+        sgl::deepFirstSearch(visitedGraph, [](EV& v) {}, [](EV& v) {});
+        resetGraph.reset();
+        bool visitedKept = std::all_of(visitedGraph.vertexBegin(), visitedGraph.vertexEnd(),
+                                       [](EV& v) { return v.flags.visited(); });
+        bool resetCleared = std::none_of(resetGraph.vertexBegin(), resetGraph.vertexEnd(),
+                                         [](EV& v) { return v.flags.visited(); });
+        if (visitedKept && resetCleared) {
+            correctCount++;
+        }
+        visitedGraph.reset();
+    }
+
+    printResult(correctCount == 16 + 3 && epochVisits == 3 * irag.vertexCount());
+
+    std::cout << "Test of articulationPoints() with ArenaAllocator" << std::endl;
+    correctCount = 0;
+
+    sgl::MonotonicArena arena(4096);
+    {
+        AAPG aapg(sgl::ArenaAllocator<AV>{arena});
+        aapg.addVertices(letters.begin(), letters.end());
+        aapg.addEdges(apEdges.begin(), apEdges.end());
+
+        std::vector<AV*> arenaApResult = {};
+        sgl::graphArticulationPoints(aapg, arenaApResult);
+
+        for (i = 0; i < arenaApResult.size(); ++i) {
+            if (arenaApResult[i]->flags.id == apCorrect[i]) {
+                correctCount++;
+            }
+        }
+    }
+
+    printResult(correctCount == 3 && arena.allocatedBytes() > 0);
+
+    std::cout << "Test of loadEdges()" << std::endl;
+    correctCount = 0;
+
+    std::vector<std::pair<int, int>> loadPairs = {
+            {5, 0}, {0, 1}, {4, 0}, {1, 0}, {3, 3}, {0, 4}, {2, 6}, {6, 2}
+    };
+    RAG loadRag = {};
+    loadRag.addVertices(letters.begin(), letters.end());
+    loadRag.loadEdges(loadPairs.begin(), loadPairs.end(),
+                      {.sortNeighbors = true, .removeDuplicates = true, .removeSelfLoops = true});
+
+    std::vector<int> loadCorrect = {1, 4, 5};
+    auto loadIt = loadCorrect.begin();
+    for (auto it = loadRag[0].vertexBegin(); it != loadRag[0].vertexEnd(); ++it, ++loadIt) {
+        if (it->flags.id == *loadIt) {
+            correctCount++;
+        }
+    }
+    if (loadRag[3].degree() == 0 && loadRag[6].degree() == 1) {
+        correctCount++;
+    }
+
+    // Deduplication keeps both adjacency entries of an undirected self-loop, so the loop
+    // survives conversion to a compressed graph.
+    std::vector<std::pair<int, int>> loopPairs = {{3, 3}, {0, 1}, {3, 3}, {1, 0}};
+    IRAG loopRag = {};
+    loopRag.addVertices(letters.begin(), letters.end());
+    loopRag.loadEdges(loopPairs.begin(), loopPairs.end(), {.removeDuplicates = true});
+    LCSG loopCsg(loopRag);
+    if (loopRag[3].degree() == 2 && loopRag[0].degree() == 1 && loopCsg.edgeCount() == 2) {
+        correctCount++;
+    }
+
+    std::vector<std::tuple<int, int, WI>> loadTups(primTups.begin(), primTups.end());
+    loadTups.emplace_back(7, 0, 1);
+    loadTups.emplace_back(4, 4, 1);
+    RAEG loadRaeg = {};
+    loadRaeg.addVertices(primChars.begin(), primChars.end());
+    loadRaeg.loadEdges(loadTups.begin(), loadTups.end(), {.removeDuplicates = true, .removeSelfLoops = true});
+
+    std::vector<ES*> loadPrimResult = {};
+    sgl::prim(loadRaeg, loadPrimResult);
+    primIt = primCorrect.begin();
+    for (auto e: loadPrimResult) {
+        if (e->from() == std::get<0>(*primIt) && e->to() == std::get<1>(*primIt)) {
+            correctCount++;
+        }
+        ++primIt;
+    }
+
+    printResult(correctCount == 5 + 8 && loadRaeg.edgeCount() == primTups.size());
+
+    std::cout << "Test of IndexedEdgeGraph with dijkstra(), prim() and floydWarshall()" << std::endl;
+    correctCount = 0;
+
+    DXG dxg = {};
+    dxg.addVertices(dijChars.begin(), dijChars.end());
+    dxg.loadEdges(dijTups.begin(), dijTups.end());
+    sgl::dijkstra(dxg, dxg[0]);
+
+    for (i = 0; i < dxg.vertexCount(); ++i) {
+        if (dxg[i].flags.dist == dijCorrect[i]) {
+            correctCount++;
+        }
+    }
+
+    auto indexedFwResult = sgl::floydWarshall(dxg);
+
+    for (i = 0; i < indexedFwResult.size(); ++i) {
+        for (size_t j = 0; j < indexedFwResult[i].size(); ++j) {
+            if (std::get<0>(indexedFwResult[i][j]) == fwCorrect[i][j]) {
+                correctCount++;
+            }
+        }
+    }
+
+    XG xg = {};
+    xg.addVertices(primChars.begin(), primChars.end());
+    xg.addEdges(primTups.begin(), primTups.end());
+    std::vector<EI*> indexedPrimResult = {};
+    sgl::prim(xg, indexedPrimResult);
+
+    primIt = primCorrect.begin();
+    for (auto e: indexedPrimResult) {
+        bool inGraph = std::any_of(xg.edgeBegin(), xg.edgeEnd(), [e](EI& edge) { return &edge == e; });
+        if (inGraph && e->from() == static_cast<int>(std::get<0>(*primIt)) &&
+            e->to() == static_cast<int>(std::get<1>(*primIt))) {
+            correctCount++;
+        }
+        ++primIt;
+    }
+
+    // Both endpoints of an undirected edge list the same record.
+    auto [xgNeighbour, xgEdge] = *xg[2].pairBegin();
+    bool sharedEdge = false;
+    for (auto it = xgNeighbour->pairBegin(); it != xgNeighbour->pairEnd(); ++it) {
+        sharedEdge = sharedEdge || ((*it).first == &xg[2] && (*it).second == xgEdge);
+    }
+    if (sharedEdge) {
+        correctCount++;
+    }
+
+    // Arcs carry a copy of the value for both endpoints of an undirected edge.
+    bool inlineValues = true;
+    for (size_t v = 0; v < xg.vertexCount(); ++v) {
+        auto edge = xg[v].edgeBegin();
+        for (auto arc = xg[v].arcBegin(); arc != xg[v].arcEnd(); ++arc, ++edge) {
+            size_t other = static_cast<size_t>(edge->from()) == v ? edge->to() : edge->from();
+            inlineValues = inlineValues && arc->target == other && arc->value.weight() == edge->value.weight();
+        }
+    }
+    if (inlineValues) {
+        correctCount++;
+    }
+
+    // Copied vertices keep their old IDs in flags until the graph renumbers them.
+    XG copiedXg = {};
+    copiedXg.addVertex(xg[5]);
+    copiedXg.addVertex(xg[8]);
+    copiedXg.addVertex(xg[2]);
+    std::vector<std::tuple<int, int, WI>> copiedTups = {{0, 1, 3}, {1, 2, 4}};
+    copiedXg.addEdges(copiedTups.begin(), copiedTups.end());
+    std::string copiedNeighbours = {};
+    for (auto it = copiedXg[1].vertexBegin(); it != copiedXg[1].vertexEnd(); ++it) {
+        copiedNeighbours += it->data;
+    }
+    if (copiedXg[2].flags.id == 2 && copiedNeighbours == "fc") {
+        correctCount++;
+    }
+
+    printResult(correctCount == 5 + 25 + 8 + 1 + 1 + 1 && xg.edgeCount() == primTups.size() &&
+                static_cast<size_t>(std::distance(xg.edgeBegin(), xg.edgeEnd())) == primTups.size());
+
+    std::cout << "Test of deepFirstSearch() and graphArticulationPoints() on a deep path" << std::endl;
+    correctCount = 0;
+
+    const size_t pathLength = 1000000;
+    APG path = {};
+    for (i = 0; i < pathLength; ++i) {
+        path.addVertex('p');
+    }
+    std::vector<std::pair<size_t, size_t>> pathEdges = {};
+    for (i = 1; i < pathLength; ++i) {
+        pathEdges.emplace_back(i - 1, i);
+    }
+    path.loadEdges(pathEdges.begin(), pathEdges.end());
+
+    size_t preorderCount = 0;
+    size_t lastFinished = pathLength;
+    sgl::deepFirstSearch(path, [&preorderCount](APV& v) {
+        ++preorderCount;
+    }, [&lastFinished](APV& v) {
+        lastFinished = v.flags.id;
+    });
+    path.reset();
+
+    std::vector<APV*> pathAP = {};
+    sgl::graphArticulationPoints(path, pathAP);
+
+    printResult(preorderCount == pathLength && lastFinished == 0 && pathAP.size() == pathLength - 2 &&
+                pathAP.front()->flags.id == pathLength - 2 && pathAP.back()->flags.id == 1);
+
+    std::cout << "Test of directionOptimizingBreadthFirstSearch()" << std::endl;
+    correctCount = 0;
+
+    const int socialSize = 4096;
+    IRAG social = {};
+    for (int v = 0; v < socialSize; ++v) {
+        social.addVertex('s');
+    }
+    std::vector<std::pair<int, int>> socialEdges = {};
+    std::uint32_t seed = 12345;
+    for (int e = 0; e < socialSize * 8; ++e) {
+        seed = seed * 1664525u + 1013904223u;
+        int from = static_cast<int>((seed >> 8) % socialSize);
+        seed = seed * 1664525u + 1013904223u;
+        int to = static_cast<int>((seed >> 8) % (from % 16 == 0 ? socialSize : 64));
+        socialEdges.emplace_back(from, to);
+    }
+    for (int v = socialSize - 8; v < socialSize - 1; ++v) {
+        socialEdges.emplace_back(v, v + 1);
+    }
+    social.loadEdges(socialEdges.begin(), socialEdges.end());
+
+    std::vector<size_t> socialDepth(socialSize, std::numeric_limits<size_t>::max());
+    std::queue<int> socialQueue = {};
+    socialDepth[0] = 0;
+    socialQueue.push(0);
+    while (!socialQueue.empty()) {
+        int v = socialQueue.front();
+        socialQueue.pop();
+        for (auto it = social[v].vertexBegin(); it != social[v].vertexEnd(); ++it) {
+            if (socialDepth[it->flags.id] == std::numeric_limits<size_t>::max()) {
+                socialDepth[it->flags.id] = socialDepth[v] + 1;
+                socialQueue.push(it->flags.id);
+            }
+        }
+    }
+
+    auto [socialParent, socialResult] = sgl::directionOptimizingBreadthFirstSearch(social, social[0]);
+    for (int v = 0; v < socialSize; ++v) {
+        bool parentCorrect = socialParent[v] == sgl::invalidID<int>();
+        if (v == 0) {
+            parentCorrect = socialParent[v] == 0;
+        } else if (!parentCorrect) {
+            parentCorrect = socialResult[socialParent[v]] + 1 == socialResult[v] &&
+                    std::any_of(social[v].vertexBegin(), social[v].vertexEnd(), [&socialParent, v](IV& u) {
+                        return u.flags.id == socialParent[v];
+                    });
+        }
+        if (socialResult[v] == socialDepth[v] && parentCorrect) {
+            correctCount++;
+        }
+    }
+
+    printResult(correctCount == socialSize);
+
+    std::cout << "Test of ThreadPool and parallelBreadthFirstSearch()" << std::endl;
+    correctCount = 0;
+
+    sgl::ThreadPool pool(4);
+    std::vector<size_t> squares(1000, 0);
+    pool.parallelFor(0, squares.size(), [&squares](size_t index, size_t) {
+        squares[index] = index * index;
+    }, 16);
+    for (i = 0; i < squares.size(); ++i) {
+        if (squares[i] == i * i) {
+            correctCount++;
+        }
+    }
+
+    auto [parallelParent, parallelDepth] = sgl::parallelBreadthFirstSearch(social, social[0], pool);
+    for (int v = 0; v < socialSize; ++v) {
+        bool parentCorrect = parallelParent[v] == sgl::invalidID<int>();
+        if (v == 0) {
+            parentCorrect = parallelParent[v] == 0;
+        } else if (!parentCorrect) {
+            parentCorrect = parallelDepth[parallelParent[v]] + 1 == parallelDepth[v];
+        }
+        if (parallelDepth[v] == socialDepth[v] && parentCorrect) {
+            correctCount++;
+        }
+    }
+
+    printResult(correctCount == squares.size() + socialSize);
+
+    std::cout << "Test of IndexedDaryHeap and dijkstra() with a target and a distance bound" << std::endl;
+    correctCount = 0;
+
+    sgl::IndexedDaryHeap<int> heap(8);
+    std::vector<int> heapPriorities = {7, 3, 9, 1, 8, 4, 6, 5};
+    for (i = 0; i < heapPriorities.size(); ++i) {
+        heap.push(i, heapPriorities[i]);
+    }
+    heap.decrease(2, 0);
+    heap.pushOrDecrease(6, 2);
+    std::vector<size_t> heapCorrect = {2, 3, 6, 1, 5, 7, 0, 4};
+    for (i = 0; !heap.empty(); ++i) {
+        size_t key = heap.top();
+        heap.pop();
+        if (key == heapCorrect[i] && !heap.contains(key)) {
+            correctCount++;
+        }
+    }
+
+    draeg.reset();
+    sgl::dijkstra(draeg, draeg[0], draeg[3]);
+    if (draeg[3].flags.dist == 5 && draeg[3].flags.visited() && !draeg[2].flags.visited()) {
+        correctCount++;
+    }
+
+    draeg.reset();
+    sgl::dijkstra(draeg, draeg[0], nullptr, 7);
+    if (draeg[4].flags.dist == 7 && draeg[4].flags.visited() && draeg[1].flags.dist == 8 &&
+        !draeg[1].flags.visited()) {
+        correctCount++;
+    }
+
+    sgl::VectorPropertyMap<int> boundDist(draeg.vertexCount());
+    sgl::VectorPropertyMap<size_t> boundPrev(draeg.vertexCount());
+    sgl::dijkstra(draeg, draeg[0], boundDist, boundPrev, &draeg[1], std::numeric_limits<int>::max());
+    if (boundDist[1] == 8 && boundPrev[1] == 3 && boundDist[2] == 13) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 8 + 3);
+
+    std::cout << "Test of deltaStepping()" << std::endl;
+    correctCount = 0;
+
+    std::vector<std::tuple<int, int, WI>> weightedSocialEdges = {};
+    for (auto [from, to]: socialEdges) {
+        seed = seed * 1664525u + 1013904223u;
+        weightedSocialEdges.emplace_back(from, to, static_cast<int>((seed >> 8) % 20) + 1);
+    }
+    XG weightedSocial = {};
+    for (int v = 0; v < socialSize; ++v) {
+        weightedSocial.addVertex('s');
+    }
+    weightedSocial.loadEdges(weightedSocialEdges.begin(), weightedSocialEdges.end());
+
+    sgl::dijkstra(weightedSocial, weightedSocial[0]);
+    std::vector<size_t> socialDist = {};
+    for (int v = 0; v < socialSize; ++v) {
+        socialDist.push_back(weightedSocial[v].flags.dist);
+    }
+
+    // Deltas below, between and above the edge weights wrap the bucket ring differently.
+    for (size_t delta: {5, 1, 3, 50}) {
+        weightedSocial.reset();
+        sgl::deltaStepping(weightedSocial, weightedSocial[0], delta, pool);
+        for (int v = 0; v < socialSize; ++v) {
+            XV& vertex = weightedSocial[v];
+            bool prevCorrect = vertex.flags.prev == nullptr;
+            if (v != 0 && vertex.flags.dist != std::numeric_limits<size_t>::max()) {
+                prevCorrect = vertex.flags.prev != nullptr && vertex.flags.prev->flags.dist < vertex.flags.dist;
+            }
+            if (vertex.flags.dist == socialDist[v] && prevCorrect) {
+                correctCount++;
+            }
+        }
+    }
+
+    printResult(correctCount == 4 * socialSize);
+
+    std::cout << "Test of bidirectionalDijkstra() and aStar()" << std::endl;
+    correctCount = 0;
+
+    sgl::WeightedAdjacency<size_t, int> reverseDraeg(draeg, true);
+    for (i = 0; i < draeg.vertexCount(); ++i) {
+        for (size_t j = 0; j < draeg.vertexCount(); ++j) {
+            auto [length, route] = sgl::bidirectionalDijkstra(draeg, draeg[i], draeg[j], reverseDraeg);
+            int routeLength = 0;
+            for (size_t k = 1; k < route.size(); ++k) {
+                routeLength += fwCorrect[route[k - 1]][route[k]];
+            }
+            if (length == fwCorrect[i][j] && routeLength == length && route.front() == i && route.back() == j) {
+                correctCount++;
+            }
+        }
+    }
+
+    weightedSocial.reset();
+    sgl::dijkstra(weightedSocial, weightedSocial[7]);
+    for (int v = 0; v < socialSize; v += 97) {
+        auto [length, route] = sgl::bidirectionalDijkstra(weightedSocial, weightedSocial[7], weightedSocial[v]);
+        if (static_cast<size_t>(length) == weightedSocial[v].flags.dist ||
+            (route.empty() && weightedSocial[v].flags.dist == std::numeric_limits<size_t>::max())) {
+            correctCount++;
+        }
+    }
+
+    const int gridSide = 32;
+    PG grid = {};
+    for (int y = 0; y < gridSide; ++y) {
+        for (int x = 0; x < gridSide; ++x) {
+            grid.addVertex(std::pair(x, y));
+        }
+    }
+    std::vector<std::tuple<int, int, WI>> gridEdges = {};
+    for (int v = 0; v < gridSide * gridSide; ++v) {
+        if (v % gridSide + 1 < gridSide) {
+            gridEdges.emplace_back(v, v + 1, 1);
+        }
+        if (v + gridSide < gridSide * gridSide) {
+            gridEdges.emplace_back(v, v + gridSide, 1);
+        }
+    }
+    grid.loadEdges(gridEdges.begin(), gridEdges.end());
+
+    PV& gridTarget = grid[gridSide * 3 + 4];
+    sgl::aStar(grid, grid[0], gridTarget, [&gridTarget](PV& v) {
+        return static_cast<size_t>(std::abs(v.data.first - gridTarget.data.first) +
+                                   std::abs(v.data.second - gridTarget.data.second));
+    });
+    size_t gridSettled = std::count_if(grid.vertexBegin(), grid.vertexEnd(), [](PV& v) { return v.flags.visited(); });
+    size_t gridSteps = 0;
+    for (PV* v = &gridTarget; v->flags.prev != nullptr; v = v->flags.prev) {
+        ++gridSteps;
+    }
+    if (gridTarget.flags.dist == 7 && gridSteps == 7 && gridSettled < 64) {
+        correctCount++;
+    }
+
+    // A second query must not be blocked by the vertices the first one settled.
+    sgl::aStar(grid, grid[gridSide * 3], gridTarget, [&gridTarget](PV& v) {
+        return static_cast<size_t>(std::abs(v.data.first - gridTarget.data.first) +
+                                   std::abs(v.data.second - gridTarget.data.second));
+    });
+    if (gridTarget.flags.dist == 4 && gridTarget.flags.prev == &grid[gridSide * 3 + 3]) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 25 + (socialSize + 96) / 97 + 1 + 1);
+
+    std::cout << "Test of landmarkTable() and landmarkSearch()" << std::endl;
+    correctCount = 0;
+
+    auto landmarks = sgl::landmarkTable(draeg, 2);
+    std::stringstream landmarkStream = {};
+    sgl::LandmarkTable<int> loadedLandmarks = {};
+    bool landmarksLoaded = landmarks.save(landmarkStream) && loadedLandmarks.load(landmarkStream);
+
+    for (i = 0; i < draeg.vertexCount(); ++i) {
+        for (size_t j = 0; j < draeg.vertexCount(); ++j) {
+            draeg.reset();
+            sgl::landmarkSearch(draeg, loadedLandmarks, draeg[i], draeg[j]);
+            if (loadedLandmarks.lowerBound(i, j) <= fwCorrect[i][j] && landmarks.upperBound(i, j) >= fwCorrect[i][j] &&
+                loadedLandmarks.upperBound(i, j) == landmarks.upperBound(i, j) &&
+                draeg[j].flags.dist == static_cast<size_t>(fwCorrect[i][j])) {
+                correctCount++;
+            }
+        }
+    }
+
+    auto gridLandmarks = sgl::landmarkTable(grid, 4);
+    grid.reset();
+    sgl::landmarkSearch(grid, gridLandmarks, grid[gridSide + 2], grid[gridSide * gridSide - 3]);
+    gridSettled = std::count_if(grid.vertexBegin(), grid.vertexEnd(), [](PV& v) { return v.flags.visited(); });
+    if (grid[gridSide * gridSide - 3].flags.dist == 2 * gridSide - 7 && gridSettled < gridSide * gridSide / 2 &&
+        gridLandmarks.lowerBound(0, gridSide * gridSide - 1) == 2 * gridSide - 2) {
+        correctCount++;
+    }
+
+    std::string savedLandmarks = landmarkStream.str();
+    std::stringstream truncatedStream(savedLandmarks.substr(0, savedLandmarks.size() - 1));
+    std::string hugeCount = savedLandmarks;
+    std::fill(hugeCount.begin() + 16, hugeCount.begin() + 24, '\x7f');
+    std::stringstream hugeStream(hugeCount);
+    if (!loadedLandmarks.load(truncatedStream) && !loadedLandmarks.load(hugeStream) &&
+        loadedLandmarks.landmarkCount() == 2 && loadedLandmarks.vertexCount() == draeg.vertexCount() &&
+        loadedLandmarks.upperBound(0, 1) == landmarks.upperBound(0, 1)) {
+        correctCount++;
+    }
+
+    // Vertices 3 to 5 hang off the start of the path 0 -> 1 -> 2 and cannot reach 2.
+    std::string deadEndChars = "abcdef";
+    std::vector<std::tuple<int, int, WI>> deadEndTups = {{0, 1, {1}}, {1, 2, {1}}, {0, 3, {1}}, {3, 4, {1}}, {4, 5, {1}}};
+    DRAEG deadEnds = {};
+    deadEnds.addVertices(deadEndChars.begin(), deadEndChars.end());
+    deadEnds.addEdges(deadEndTups.begin(), deadEndTups.end());
+    auto deadEndLandmarks = sgl::landmarkTable(deadEnds, deadEndChars.size());
+    auto deadEndUntouched = [&deadEnds](size_t from) {
+        bool untouched = true;
+        for (size_t v = from; v < deadEnds.vertexCount(); ++v) {
+            untouched = untouched && !deadEnds[v].flags.visited() && deadEnds[v].flags.dist == std::numeric_limits<size_t>::max();
+        }
+        return untouched;
+    };
+
+    sgl::landmarkSearch(deadEnds, deadEndLandmarks, deadEnds[0], deadEnds[2]);
+    bool deadEndsSkipped = deadEnds[2].flags.dist == 2 && deadEndUntouched(3);
+    deadEnds.reset();
+    sgl::aStar(deadEnds, deadEnds[0], deadEnds[2], [](VEV& v) {
+        return v.flags.id >= 3 ? std::numeric_limits<size_t>::max() : 2 - std::min<size_t>(v.flags.id, 2);
+    });
+    deadEndsSkipped = deadEndsSkipped && deadEnds[2].flags.dist == 2 && deadEndUntouched(3);
+    deadEnds.reset();
+    sgl::landmarkSearch(deadEnds, deadEndLandmarks, deadEnds[5], deadEnds[2]);
+    bool nothingSettled = std::none_of(deadEnds.vertexBegin(), deadEnds.vertexEnd(), [](VEV& v) { return v.flags.visited(); });
+    if (deadEndsSkipped && nothingSettled && deadEnds[2].flags.dist == std::numeric_limits<size_t>::max()) {
+        correctCount++;
+    }
+
+    printResult(landmarksLoaded && loadedLandmarks.landmarkCount() == 2 && correctCount == 25 + 1 + 1 + 1);
+
+    std::cout << "Test of contractionHierarchy()" << std::endl;
+    correctCount = 0;
+
+    auto hierarchy = sgl::contractionHierarchy(draeg);
+    for (i = 0; i < draeg.vertexCount(); ++i) {
+        for (size_t j = 0; j < draeg.vertexCount(); ++j) {
+            auto [length, route] = hierarchy.shortestPath(i, j);
+            int routeLength = 0;
+            for (size_t k = 1; k < route.size(); ++k) {
+                routeLength += fwCorrect[route[k - 1]][route[k]];
+            }
+            if (length == fwCorrect[i][j] && routeLength == length && route.front() == i && route.back() == j) {
+                correctCount++;
+            }
+        }
+    }
+
+    auto gridHierarchy = sgl::contractionHierarchy(grid);
+    auto [gridLength, gridRoute] = gridHierarchy.shortestPath(gridSide + 2, gridSide * gridSide - 3);
+    bool gridRouteCorrect = gridRoute.size() == static_cast<size_t>(gridLength) + 1;
+    for (size_t k = 1; k < gridRoute.size(); ++k) {
+        int step = std::abs(gridRoute[k] - gridRoute[k - 1]);
+        gridRouteCorrect = gridRouteCorrect && (step == 1 || step == gridSide);
+    }
+    if (gridLength == 2 * gridSide - 7 && gridRouteCorrect) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 25 + 1);
+
+    std::cout << "Test of floydWarshallMatrix()" << std::endl;
+    correctCount = 0;
+
+    auto blockedMatrix = sgl::floydWarshallMatrix(draeg, &pool, 2);
+    for (i = 0; i < blockedMatrix.size(); ++i) {
+        for (size_t j = 0; j < blockedMatrix.size(); ++j) {
+            auto route = blockedMatrix.path(i, j);
+            int routeLength = 0;
+            for (size_t k = 1; k < route.size(); ++k) {
+                routeLength += fwCorrect[route[k - 1]][route[k]];
+            }
+            if (blockedMatrix.distance(i, j) == fwCorrect[i][j] && routeLength == fwCorrect[i][j]) {
+                correctCount++;
+            }
+        }
+    }
+
+    const int potentialSize = 150;
+    std::vector<int> potential = {};
+    for (int v = 0; v < potentialSize; ++v) {
+        seed = seed * 1664525u + 1013904223u;
+        potential.push_back(static_cast<int>((seed >> 8) % 50));
+    }
+    std::vector<std::tuple<int, int, WI>> potentialEdges = {};
+    for (int e = 0; e < potentialSize * 6; ++e) {
+        seed = seed * 1664525u + 1013904223u;
+        int from = static_cast<int>((seed >> 8) % potentialSize);
+        seed = seed * 1664525u + 1013904223u;
+        int to = static_cast<int>((seed >> 8) % potentialSize);
+        potentialEdges.emplace_back(from, to, static_cast<int>(seed % 20) + 1 + potential[from] - potential[to]);
+    }
+    DXG potentialGraph = {};
+    for (int v = 0; v < potentialSize; ++v) {
+        potentialGraph.addVertex('p');
+    }
+    potentialGraph.loadEdges(potentialEdges.begin(), potentialEdges.end(), {false, true, true});
+
+    auto referenceMatrix = sgl::floydWarshall(potentialGraph);
+    auto sequentialMatrix = sgl::floydWarshallMatrix(potentialGraph, nullptr, 16);
+    auto parallelMatrix = sgl::floydWarshallMatrix(potentialGraph, &pool, 32);
+    size_t matrixCorrect = 0;
+    for (int a = 0; a < potentialSize; ++a) {
+        for (int b = 0; b < potentialSize; ++b) {
+            int reference = std::get<0>(referenceMatrix[a][b]);
+            bool same = reference == std::numeric_limits<int>::max() ?
+                        !sequentialMatrix.reachable(a, b) && !parallelMatrix.reachable(a, b) :
+                        sequentialMatrix.distance(a, b) == reference && parallelMatrix.distance(a, b) == reference;
+            if (same) {
+                matrixCorrect++;
+            }
+        }
+    }
+
+    printResult(correctCount == 25 && matrixCorrect == potentialSize * potentialSize);
+
+    std::cout << "Test of johnson()" << std::endl;
+    correctCount = 0;
+
+    std::vector<std::vector<int>> johnsonRows(potentialSize);
+    bool johnsonDone = sgl::johnson(potentialGraph, pool, [&johnsonRows](size_t source, const std::vector<int>& row) {
+        johnsonRows[source] = row;
+    });
+    for (int a = 0; a < potentialSize; ++a) {
+        for (int b = 0; b < potentialSize; ++b) {
+            if (johnsonRows[a][b] == std::get<0>(referenceMatrix[a][b])) {
+                correctCount++;
+            }
+        }
+    }
+
+    DXG negativeCycle = {};
+    negativeCycle.addVertices(dijChars.begin(), dijChars.end());
+    std::vector<std::tuple<int, int, WI>> negativeEdges = {{0, 1, 2}, {1, 2, -3}, {2, 1, 1}, {2, 3, 4}};
+    negativeCycle.addEdges(negativeEdges.begin(), negativeEdges.end());
+    bool negativeDetected = !sgl::johnson(negativeCycle, pool, [&correctCount](size_t, const std::vector<int>&) {
+        correctCount = 0;
+    });
+
+    printResult(johnsonDone && negativeDetected && correctCount == potentialSize * potentialSize);
+
+    std::cout << "Test of dinic() and pushRelabel()" << std::endl;
+    correctCount = 0;
+
+    DFG dinicGraph = {};
+    dinicGraph.addVertices(ekChars.begin(), ekChars.end());
+    FV::insertFlowEdges(dinicGraph, ekEdges.begin(), ekEdges.end());
+    if (sgl::dinic(dinicGraph, dinicGraph[0], dinicGraph[6]) == 5) {
+        correctCount++;
+    }
+
+    DFG pushGraph = {};
+    pushGraph.addVertices(ekChars.begin(), ekChars.end());
+    FV::insertFlowEdges(pushGraph, ekEdges.begin(), ekEdges.end());
+    if (sgl::pushRelabel(pushGraph, pushGraph[0], pushGraph[6]) == 5) {
+        correctCount++;
+    }
+
+    const int networkSize = 300;
+    std::vector<std::tuple<int, int, int>> networkEdges = {};
+    for (int e = 0; e < networkSize * 8; ++e) {
+        seed = seed * 1664525u + 1013904223u;
+        int from = static_cast<int>((seed >> 8) % networkSize);
+        seed = seed * 1664525u + 1013904223u;
+        int to = static_cast<int>((seed >> 8) % networkSize);
+        if (from != to) {
+            networkEdges.emplace_back(from, to, static_cast<int>(seed % 50) + 1);
+        }
+    }
+    std::vector<char> networkChars(networkSize, 'n');
+    DFG networks[3] = {};
+    for (DFG& network: networks) {
+        network.addVertices(networkChars.begin(), networkChars.end());
+        FV::insertFlowEdges(network, networkEdges.begin(), networkEdges.end());
+    }
+    int networkFlows[3] = {
+            sgl::edmondsKarp<DFG, VEF, int>(networks[0], networks[0][0], networks[0][networkSize - 1]),
+            sgl::dinic(networks[1], networks[1][0], networks[1][networkSize - 1]),
+            sgl::pushRelabel(networks[2], networks[2][0], networks[2][networkSize - 1])
+    };
+    if (networkFlows[0] > 0 && networkFlows[0] == networkFlows[1] && networkFlows[0] == networkFlows[2]) {
+        correctCount++;
+    }
+
+    std::vector<int> networkExcess(networkSize, 0);
+    bool capacitiesRespected = true;
+    for (auto it = networks[2].edgeBegin(); it != networks[2].edgeEnd(); ++it) {
+        networkExcess[it->to()] += it->value.flow();
+        capacitiesRespected = capacitiesRespected && it->value.flow() <= it->value.capacity();
+    }
+    bool conserved = networkExcess[networkSize - 1] == networkFlows[2];
+    for (int v = 1; v < networkSize - 1; ++v) {
+        conserved = conserved && networkExcess[v] == 0;
+    }
+    if (capacitiesRespected && conserved) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 4);
+
+    std::cout << "Test of updateCapacities()" << std::endl;
+    correctCount = 0;
+
+    std::vector<std::tuple<int, int, int>> capacityUpdates = {};
+    std::vector<std::tuple<int, int, int>> updatedEdges = networkEdges;
+    for (size_t e = 0; e < updatedEdges.size(); ++e) {
+        if (e % 23 != 0 && std::get<1>(updatedEdges[e]) != networkSize - 1) {
+            continue;
+        }
+        seed = seed * 1664525u + 1013904223u;
+        auto& [from, to, capacity] = updatedEdges[e];
+        bool duplicate = std::any_of(updatedEdges.begin(), updatedEdges.begin() + static_cast<long>(e),
+                                     [from, to](const std::tuple<int, int, int>& earlier) {
+                                         return std::get<0>(earlier) == from && std::get<1>(earlier) == to;
+                                     });
+        if (duplicate) {
+            continue;
+        }
+        if (to == networkSize - 1) {
+            capacity /= 2;
+        } else {
+            capacity = (seed >> 8) % 3 == 0 ? capacity + 20 : static_cast<int>((seed >> 8) % 5);
+        }
+        capacityUpdates.emplace_back(from, to, capacity);
+    }
+
+    DFG freshNetwork = {};
+    freshNetwork.addVertices(networkChars.begin(), networkChars.end());
+    FV::insertFlowEdges(freshNetwork, updatedEdges.begin(), updatedEdges.end());
+    int freshFlow = sgl::dinic(freshNetwork, freshNetwork[0], freshNetwork[networkSize - 1]);
+
+    sgl::FlowRepairBuffers<FE> repairBuffers = {};
+    int warmFlow = sgl::updateCapacities(networks[1], networks[1][0], networks[1][networkSize - 1],
+                                         capacityUpdates.begin(), capacityUpdates.end(), repairBuffers);
+    if (warmFlow == freshFlow && warmFlow != networkFlows[1]) {
+        correctCount++;
+    }
+
+    std::fill(networkExcess.begin(), networkExcess.end(), 0);
+    capacitiesRespected = true;
+    for (auto it = networks[1].edgeBegin(); it != networks[1].edgeEnd(); ++it) {
+        networkExcess[it->to()] += it->value.flow();
+        capacitiesRespected = capacitiesRespected && it->value.flow() <= it->value.capacity();
+    }
+    conserved = networkExcess[networkSize - 1] == warmFlow;
+    for (int v = 1; v < networkSize - 1; ++v) {
+        conserved = conserved && networkExcess[v] == 0;
+    }
+    if (capacitiesRespected && conserved) {
+        correctCount++;
+    }
+
+    // Restoring the original capacities with the same buffers must recover the original flow.
+    std::vector<std::tuple<int, int, int>> restoredCapacities = {};
+    for (auto [from, to, capacity]: capacityUpdates) {
+        auto original = std::find_if(networkEdges.begin(), networkEdges.end(), [from, to](const std::tuple<int, int, int>& edge) {
+            return std::get<0>(edge) == from && std::get<1>(edge) == to;
+        });
+        restoredCapacities.emplace_back(from, to, std::get<2>(*original));
+    }
+    int restoredFlow = sgl::updateCapacities(networks[1], networks[1][0], networks[1][networkSize - 1],
+                                             restoredCapacities.begin(), restoredCapacities.end(), repairBuffers);
+    if (restoredFlow == networkFlows[1]) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 3);
+
+    std::cout << "Test of hopcroftKarp()" << std::endl;
+    correctCount = 0;
+
+    IRAG chain = {};
+    std::vector<std::pair<int, int>> chainEdges = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}};
+    chain.addVertices(networkChars.begin(), networkChars.begin() + 7);
+    chain.addEdges(chainEdges.begin(), chainEdges.end());
+    auto [chainMatched, chainMate] = sgl::hopcroftKarp(chain, [](IV& v) { return v.flags.id % 2 == 0; });
+    bool chainAdjacent = true;
+    for (int v = 1; v < 7; v += 2) {
+        chainAdjacent = chainAdjacent && std::abs(chainMate[v] - v) == 1 && chainMate[chainMate[v]] == v;
+    }
+    if (chainMatched == 3 && chainAdjacent) {
+        correctCount++;
+    }
+
+    const int sideSize = 500;
+    IRAG bipartite = {};
+    std::vector<char> bipartiteChars(2 * sideSize, 'b');
+    bipartite.addVertices(bipartiteChars.begin(), bipartiteChars.end());
+    std::vector<std::pair<int, int>> bipartiteEdges = {};
+    std::vector<std::tuple<int, int, int>> matchingEdges = {};
+    for (int u = 0; u < sideSize; ++u) {
+        matchingEdges.emplace_back(2 * sideSize, u, 1);
+        matchingEdges.emplace_back(sideSize + u, 2 * sideSize + 1, 1);
+        for (int k = 0; k < 3; ++k) {
+            seed = seed * 1664525u + 1013904223u;
+            int v = sideSize + static_cast<int>((seed >> 8) % (sideSize / 2 + u % (sideSize / 2)));
+            bipartiteEdges.emplace_back(u, v);
+            matchingEdges.emplace_back(u, v, 1);
+        }
+    }
+    bipartite.addEdges(bipartiteEdges.begin(), bipartiteEdges.end());
+    auto [matched, mate] = sgl::hopcroftKarp(bipartite, [](IV& v) { return v.flags.id < sideSize; });
+
+    DFG matchingNetwork = {};
+    bipartiteChars.resize(2 * sideSize + 2, 'b');
+    matchingNetwork.addVertices(bipartiteChars.begin(), bipartiteChars.end());
+    FV::insertFlowEdges(matchingNetwork, matchingEdges.begin(), matchingEdges.end());
+    int matchingFlow = sgl::dinic(matchingNetwork, matchingNetwork[2 * sideSize], matchingNetwork[2 * sideSize + 1]);
+    if (matched == static_cast<size_t>(matchingFlow) && matched < static_cast<size_t>(sideSize)) {
+        correctCount++;
+    }
+
+    size_t mateCount = 0;
+    bool mateConsistent = true;
+    for (int u = 0; u < sideSize; ++u) {
+        if (mate[u] == sgl::invalidID<int>()) {
+            continue;
+        }
+        ++mateCount;
+        bool adjacent = std::any_of(bipartiteEdges.begin(), bipartiteEdges.end(), [u, &mate](const std::pair<int, int>& e) {
+            return e.first == u && e.second == mate[u];
+        });
+        mateConsistent = mateConsistent && adjacent && mate[mate[u]] == u;
+    }
+    if (mateConsistent && mateCount == matched) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 3);
+
+    std::cout << "Test of kruskal() and boruvka()" << std::endl;
+    correctCount = 0;
+
+    RAEG kruskalGraph = {};
+    kruskalGraph.addVertices(primChars.begin(), primChars.end());
+    kruskalGraph.addEdges(primTups.begin(), primTups.end());
+    std::vector<ES*> kruskalResult = {};
+    sgl::kruskal(kruskalGraph, kruskalResult);
+    std::vector<ES*> boruvkaResult = {};
+    sgl::boruvka(kruskalGraph, boruvkaResult, pool);
+
+    auto forestWeight = [](const std::vector<ES*>& forest) {
+        int total = 0;
+        for (ES* edge: forest) {
+            total += edge->value.weight();
+        }
+        return total;
+    };
+    if (kruskalResult.size() == 8 && forestWeight(kruskalResult) == 37 &&
+        boruvkaResult.size() == 8 && forestWeight(boruvkaResult) == 37) {
+        correctCount++;
+    }
+
+    const int forestSize = 20000;
+    std::vector<char> forestChars(forestSize, 'f');
+    std::vector<std::tuple<int, int, WI>> forestTups = {};
+    for (int e = 0; e < forestSize * 4; ++e) {
+        seed = seed * 1664525u + 1013904223u;
+        int from = static_cast<int>((seed >> 8) % forestSize);
+        seed = seed * 1664525u + 1013904223u;
+        int to = static_cast<int>((seed >> 8) % forestSize);
+        // Even and odd vertices form separate components.
+        to ^= (to + from) % 2;
+        forestTups.emplace_back(from, to, static_cast<int>(seed % 100));
+    }
+    RAEG forest = {};
+    forest.addVertices(forestChars.begin(), forestChars.end());
+    forest.loadEdges(forestTups.begin(), forestTups.end());
+
+    std::vector<ES*> forestKruskal = {};
+    sgl::kruskal(forest, forestKruskal, &pool);
+    std::vector<ES*> forestSequential = {};
+    sgl::kruskal(forest, forestSequential);
+    std::vector<ES*> forestBoruvka = {};
+    sgl::boruvka(forest, forestBoruvka, pool);
+    if (forestKruskal == forestSequential && forestBoruvka.size() == forestKruskal.size() &&
+        forestWeight(forestBoruvka) == forestWeight(forestKruskal)) {
+        correctCount++;
+    }
+
+    sgl::DisjointSets<int> forestTrees(forestSize);
+    for (ES* edge: forestBoruvka) {
+        forestTrees.unite(edge->from(), edge->to());
+    }
+    if (forestTrees.setCount() == forestSize - forestBoruvka.size() && forestTrees.setCount() >= 2 &&
+        !forestTrees.connected(0, 1)) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 3);
+
+    std::cout << "Test of stronglyConnectedComponentLabels()" << std::endl;
+    correctCount = 0;
+
+    dag.reset();
+    auto [dagComponents, dagLabels] = sgl::stronglyConnectedComponentLabels(dag);
+    for (auto& component: sccCorrect) {
+        for (int v: component) {
+            for (int u = 0; u < static_cast<int>(dagLabels.size()); ++u) {
+                bool together = std::find(component.begin(), component.end(), u) != component.end();
+                if ((dagLabels[u] == dagLabels[v]) == together) {
+                    correctCount++;
+                }
+            }
+        }
+    }
+    bool reverseTopological = dagComponents == 4;
+    for (auto [from, to]: dagEdges) {
+        reverseTopological = reverseTopological && dagLabels[from] >= dagLabels[to];
+    }
+    if (reverseTopological) {
+        correctCount++;
+    }
+
+    DAG cycle = {};
+    std::vector<char> cycleChars(pathLength, 'c');
+    cycle.addVertices(cycleChars.begin(), cycleChars.end());
+    std::vector<std::pair<int, int>> cycleEdges = {};
+    for (size_t v = 0; v < pathLength; ++v) {
+        cycleEdges.emplace_back(static_cast<int>(v), static_cast<int>((v + 1) % (pathLength / 2)));
+    }
+    cycle.loadEdges(cycleEdges.begin(), cycleEdges.end());
+    auto [cycleComponents, cycleLabels] = sgl::stronglyConnectedComponentLabels(cycle);
+    if (cycleComponents == pathLength / 2 + 1 && cycleLabels[0] == cycleLabels[pathLength / 2 - 1] &&
+        cycleLabels[pathLength / 2] != cycleLabels[pathLength - 1]) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 8 * 8 + 2);
+
+    std::cout << "Test of parallelStronglyConnectedComponents()" << std::endl;
+    correctCount = 0;
+
+    auto [parallelDagComponents, parallelDagLabels] = sgl::parallelStronglyConnectedComponents(dag, pool);
+    std::vector<int> dagLabelsCorrect = {0, 0, 1, 1, 0, 2, 2, 3};
+    if (parallelDagComponents == 4 && parallelDagLabels == dagLabelsCorrect) {
+        correctCount++;
+    }
+
+    const int callGraphSize = 50000;
+    DAG callGraph = {};
+    std::vector<char> callGraphChars(callGraphSize, 'g');
+    callGraph.addVertices(callGraphChars.begin(), callGraphChars.end());
+    std::vector<std::pair<int, int>> callEdges = {};
+    for (int e = 0; e < callGraphSize * 2; ++e) {
+        seed = seed * 1664525u + 1013904223u;
+        int from = static_cast<int>((seed >> 8) % callGraphSize);
+        seed = seed * 1664525u + 1013904223u;
+        // Mostly short forward calls, so there are long chains and many small cycles.
+        int to = (seed >> 8) % 4 == 0 ? static_cast<int>((seed >> 10) % callGraphSize) : (from + 1 + static_cast<int>((seed >> 10) % 8)) % callGraphSize;
+        callEdges.emplace_back(from, to);
+    }
+    callGraph.loadEdges(callEdges.begin(), callEdges.end());
+
+    auto [sequentialCount, sequentialLabels] = sgl::stronglyConnectedComponentLabels(callGraph);
+    auto [parallelCount, parallelLabels] = sgl::parallelStronglyConnectedComponents(callGraph, pool);
+    std::vector<int> labelMap(sequentialCount, -1);
+    bool samePartition = sequentialCount == parallelCount && sequentialCount > 1;
+    int nextLabel = 0;
+    for (int v = 0; v < callGraphSize && samePartition; ++v) {
+        int& mapped = labelMap[sequentialLabels[v]];
+        if (mapped == -1) {
+            samePartition = parallelLabels[v] == nextLabel++;
+            mapped = parallelLabels[v];
+        }
+        samePartition = samePartition && mapped == parallelLabels[v];
+    }
+    if (samePartition) {
+        correctCount++;
+    }
+
+    sgl::ThreadPool singlePool(1);
+    auto [singleCount, singleLabels] = sgl::parallelStronglyConnectedComponents(callGraph, singlePool);
+    if (singleCount == parallelCount && singleLabels == parallelLabels) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 3);
+
+    std::cout << "Test of biconnectedComponents()" << std::endl;
+    correctCount = 0;
+
+    auto blocks = sgl::biconnectedComponents(apg);
+    std::vector<size_t> cutCorrect = {0, 1, 2};
+    std::vector<std::pair<size_t, size_t>> bridgesCorrect = {{0, 1}, {0, 4}};
+    if (blocks.cutVertices == cutCorrect && blocks.bridges == bridgesCorrect && blocks.blockCount == 4) {
+        correctCount++;
+    }
+
+    auto edgeBlock = [&apg, &blocks](size_t from, size_t to) {
+        size_t arc = 0;
+        for (auto it = apg[from].vertexBegin(); it->flags.id != to; ++it) {
+            ++arc;
+        }
+        return blocks.block(from, arc);
+    };
+    std::vector<size_t> apEdgeBlocks = {2, 3, 0, 0, 1, 0, 1, 1, 0};
+    for (size_t e = 0; e < apEdges.size(); ++e) {
+        auto [from, to] = apEdges[e];
+        if (edgeBlock(from, to) == edgeBlock(to, from)) {
+            correctCount++;
+        }
+        for (size_t f = 0; f < apEdges.size(); ++f) {
+            bool sameBlock = edgeBlock(from, to) == edgeBlock(std::get<0>(apEdges[f]), std::get<1>(apEdges[f]));
+            if (sameBlock == (apEdgeBlocks[e] == apEdgeBlocks[f])) {
+                correctCount++;
+            }
+        }
+    }
+
+    auto pathBlocks = sgl::biconnectedComponents(path);
+    if (pathBlocks.cutVertices.size() == pathLength - 2 && pathBlocks.bridges.size() == pathLength - 1 &&
+        pathBlocks.blockCount == pathLength - 1 && pathBlocks.block(1, 0) == pathBlocks.block(0, 0)) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 1 + apEdges.size() * (apEdges.size() + 1) + 1);
+
+    std::cout << "Test of connectedComponents(), afforestConnectedComponents() and shiloachVishkin()" << std::endl;
+    correctCount = 0;
+
+    auto [forestCount, forestLabels] = sgl::connectedComponents(forest);
+    auto [afforestCount, afforestLabels] = sgl::afforestConnectedComponents(forest, pool);
+    auto [svCount, svLabels] = sgl::shiloachVishkin(forest, pool);
+    if (forestCount == forestTrees.setCount() && forestLabels[0] == 0 && forestLabels[1] == 1 &&
+        afforestCount == forestCount && afforestLabels == forestLabels &&
+        svCount == forestCount && svLabels == forestLabels) {
+        correctCount++;
+    }
+
+    auto [socialCount, socialLabels] = sgl::connectedComponents(social);
+    if (sgl::afforestConnectedComponents(social, pool, 1) == std::pair(socialCount, socialLabels) &&
+        sgl::shiloachVishkin(social, singlePool) == std::pair(socialCount, socialLabels)) {
+        correctCount++;
+    }
+
+    auto [csgCount, csgLabels] = sgl::afforestConnectedComponents(csg, pool);
+    if (csgCount == 1 && sgl::shiloachVishkin(csg, pool).first == 1) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 3);
+
+    std::cout << "Test of IncrementalConnectivityGraph" << std::endl;
+    correctCount = 0;
+
+    sgl::IncrementalConnectivityGraph<IRAG> growing = {};
+    std::vector<char> growingChars(socialSize / 2, 'g');
+    growing.addVertices(growingChars.begin(), growingChars.end());
+    for (auto [from, to]: socialEdges) {
+        if (from < socialSize / 2 && to < socialSize / 2) {
+            growing.addEdge(from, to);
+        }
+    }
+    auto [halfCount, halfLabels] = sgl::connectedComponents(growing);
+    if (growing.componentCount() == halfCount && growing.connected(0, 0)) {
+        correctCount++;
+    }
+
+    for (int v = socialSize / 2; v < socialSize; ++v) {
+        growing.addVertex('g');
+    }
+    std::vector<std::pair<int, int>> remainingEdges = {};
+    std::copy_if(socialEdges.begin(), socialEdges.end(), std::back_inserter(remainingEdges), [](auto edge) {
+        return edge.first >= socialSize / 2 || edge.second >= socialSize / 2;
+    });
+    growing.loadEdges(remainingEdges.begin(), remainingEdges.end());
+
+    bool sameComponents = growing.componentCount() == socialCount;
+    for (int v = 0; v < socialSize; v += 7) {
+        for (int u = 0; u < socialSize; u += 131) {
+            sameComponents = sameComponents && growing.connected(u, v) == (socialLabels[u] == socialLabels[v]);
+        }
+        sameComponents = sameComponents && socialLabels[growing.componentOf(v)] == socialLabels[v];
+    }
+    if (sameComponents && growing.vertexCount() == static_cast<size_t>(socialSize)) {
+        correctCount++;
+    }
+
+    printResult(correctCount == 2);
+
     return 0;
 }
@@ -1,12 +1,24 @@
 #ifndef SGL_CLASSES_HPP
 #define SGL_CLASSES_HPP
 
+#include <algorithm>
+#include <atomic>
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
+#include <istream>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -37,6 +49,741 @@ namespace sgl {
         void reset() { visited_ = false; }
     };
 
+    // Visited means "stamped with the current epoch". The epoch counter belongs to the graph
+    // holding the vertex, which binds every flag to it on insertion, so advancing it in the
+    // graph's reset() un-visits that graph's vertices at once and no others. The graph only
+    // walks its vertices when the counter wraps around.
+    class EpochVisitIntIDFlag {
+    public:
+        using EpochType = std::uint32_t;
+    private:
+        static constexpr EpochType UNBOUND_EPOCH = 1;
+        const EpochType* epoch_ = &UNBOUND_EPOCH;
+        EpochType stamp_ = 0;
+    public:
+        using IDType = int;
+        IDType id;
+
+        EpochVisitIntIDFlag() : epoch_{&UNBOUND_EPOCH}, stamp_{0}, id{0} {}
+        explicit EpochVisitIntIDFlag(const int ID) : epoch_{&UNBOUND_EPOCH}, stamp_{0}, id{ID} {}
+
+        void visit() { stamp_ = *epoch_; }
+        bool visited() const { return stamp_ == *epoch_; }
+        void reset() { stamp_ = 0; }
+
+        // A stamp means nothing under another graph's counter, so binding also un-visits.
+        void bindEpoch(const EpochType* epoch) {
+            epoch_ = epoch;
+            stamp_ = 0;
+        }
+    };
+
+    // Epoch counter of one graph. It lives on the heap so bound flags keep pointing at it when
+    // the graph is moved; a copied graph starts a counter of its own. For flags without
+    // epochs it is empty and advance() always asks the graph to reset every vertex.
+    template <typename Flag>
+    class GraphEpoch {
+    public:
+        void bind(Flag&) {}
+        bool advance() { return false; }
+    };
+
+    template <FlagEpoch Flag>
+    class GraphEpoch<Flag> {
+    public:
+        using EpochType = typename Flag::EpochType;
+
+        GraphEpoch() : epoch_{std::make_unique<EpochType>(1)} {}
+        GraphEpoch(const GraphEpoch&) : GraphEpoch() {}
+        GraphEpoch(GraphEpoch&& e) noexcept = default;
+        GraphEpoch& operator=(const GraphEpoch&) { return *this; }
+        GraphEpoch& operator=(GraphEpoch&& e) noexcept = default;
+
+        void bind(Flag& flag) {
+            if (epoch_ == nullptr) {
+                epoch_ = std::make_unique<EpochType>(1);
+            }
+            flag.bindEpoch(epoch_.get());
+        }
+
+        // Returns false on wraparound, after which stale stamps have to be cleared by the graph.
+        bool advance() {
+            if (epoch_ == nullptr || ++*epoch_ != 0) {
+                return epoch_ != nullptr;
+            }
+            *epoch_ = 1;
+            return false;
+        }
+
+    private:
+        std::unique_ptr<EpochType> epoch_;
+    };
+
+    template <typename IDT>
+    class IDFlag {
+    public:
+        using IDType = IDT;
+        IDType id;
+
+        IDFlag() : id{0} {}
+        explicit IDFlag(const IDType ID) : id{ID} {}
+
+        void reset() {}
+    };
+
+    template <std::integral IDType>
+    constexpr IDType invalidID() {
+        return std::numeric_limits<IDType>::max();
+    }
+
+    class BitsetVisitMap {
+    private:
+        std::vector<std::uint64_t> words_;
+        size_t size_;
+    public:
+        BitsetVisitMap() : words_{}, size_{0} {}
+        explicit BitsetVisitMap(size_t size) : words_((size + 63) / 64, 0), size_{size} {}
+
+        void visit(size_t key) { words_[key >> 6] |= std::uint64_t{1} << (key & 63); }
+        bool visited(size_t key) const { return (words_[key >> 6] >> (key & 63)) & 1; }
+        void reset() { std::fill(words_.begin(), words_.end(), 0); }
+
+        void resize(size_t size) {
+            words_.assign((size + 63) / 64, 0);
+            size_ = size;
+        }
+
+        size_t size() const { return size_; }
+    };
+
+    class EpochVisitMap {
+    private:
+        std::vector<std::uint32_t> stamps_;
+        std::uint32_t epoch_;
+    public:
+        EpochVisitMap() : stamps_{}, epoch_{1} {}
+        explicit EpochVisitMap(size_t size) : stamps_(size, 0), epoch_{1} {}
+
+        void visit(size_t key) { stamps_[key] = epoch_; }
+        bool visited(size_t key) const { return stamps_[key] == epoch_; }
+
+        void reset() {
+            if (++epoch_ == 0) {
+                std::fill(stamps_.begin(), stamps_.end(), 0);
+                epoch_ = 1;
+            }
+        }
+
+        void resize(size_t size) {
+            stamps_.assign(size, 0);
+            epoch_ = 1;
+        }
+
+        size_t size() const { return stamps_.size(); }
+    };
+
+    template <typename Value>
+    class VectorPropertyMap {
+    private:
+        std::vector<Value> values_;
+        Value initial_;
+    public:
+        using ValueType = Value;
+
+        VectorPropertyMap() : values_{}, initial_{} {}
+        explicit VectorPropertyMap(size_t size, const Value& initial = Value{}) :
+            values_(size, initial), initial_{initial} {}
+
+        Value& operator[] (size_t key) { return values_[key]; }
+        const Value& operator[] (size_t key) const { return values_[key]; }
+
+        void reset() { std::fill(values_.begin(), values_.end(), initial_); }
+        void resize(size_t size) { values_.assign(size, initial_); }
+
+        size_t size() const { return values_.size(); }
+        Value* data() { return values_.data(); }
+    };
+
+    // Min-heap over keys 0..capacity-1 that tracks every key's position, so the priority of
+    // a queued key can be lowered in place instead of pushing a duplicate.
+    template <typename Priority, size_t Arity = 4>
+    requires (Arity >= 2)
+    class IndexedDaryHeap {
+    private:
+        using Entry = std::pair<Priority, size_t>;
+        static constexpr size_t NOT_QUEUED = std::numeric_limits<size_t>::max();
+
+        std::vector<Entry> heap_;
+        std::vector<size_t> positions_;
+    public:
+        using PriorityType = Priority;
+
+        IndexedDaryHeap() : heap_{}, positions_{} {}
+        explicit IndexedDaryHeap(size_t capacity) : heap_{}, positions_(capacity, NOT_QUEUED) {}
+
+        bool empty() const { return heap_.empty(); }
+        size_t size() const { return heap_.size(); }
+        bool contains(size_t key) const { return positions_[key] != NOT_QUEUED; }
+
+        size_t top() const { return heap_.front().second; }
+        Priority topPriority() const { return heap_.front().first; }
+        Priority priority(size_t key) const { return heap_[positions_[key]].first; }
+
+        void push(size_t key, Priority priority) {
+            heap_.emplace_back(priority, key);
+            positions_[key] = heap_.size() - 1;
+            siftUp(heap_.size() - 1);
+        }
+
+        // The new priority must not be greater than the current one.
+        void decrease(size_t key, Priority priority) {
+            heap_[positions_[key]].first = priority;
+            siftUp(positions_[key]);
+        }
+
+        void pushOrDecrease(size_t key, Priority priority) {
+            if (contains(key)) {
+                decrease(key, priority);
+            } else {
+                push(key, priority);
+            }
+        }
+
+        void pop() {
+            positions_[heap_.front().second] = NOT_QUEUED;
+            if (heap_.size() > 1) {
+                place(0, heap_.back());
+                heap_.pop_back();
+                siftDown(0);
+            } else {
+                heap_.pop_back();
+            }
+        }
+
+        void clear() {
+            for (const Entry& entry: heap_) {
+                positions_[entry.second] = NOT_QUEUED;
+            }
+            heap_.clear();
+        }
+
+        void resize(size_t capacity) {
+            heap_.clear();
+            positions_.assign(capacity, NOT_QUEUED);
+        }
+
+    private:
+        void place(size_t position, const Entry& entry) {
+            heap_[position] = entry;
+            positions_[entry.second] = position;
+        }
+
+        void siftUp(size_t position) {
+            Entry entry = heap_[position];
+            while (position > 0) {
+                size_t parent = (position - 1) / Arity;
+                if (!(entry.first < heap_[parent].first)) {
+                    break;
+                }
+                place(position, heap_[parent]);
+                position = parent;
+            }
+            place(position, entry);
+        }
+
+        void siftDown(size_t position) {
+            Entry entry = heap_[position];
+            while (true) {
+                size_t first = position * Arity + 1;
+                if (first >= heap_.size()) {
+                    break;
+                }
+                size_t last = std::min(first + Arity, heap_.size());
+                size_t best = first;
+                for (size_t child = first + 1; child < last; ++child) {
+                    if (heap_[child].first < heap_[best].first) {
+                        best = child;
+                    }
+                }
+                if (!(heap_[best].first < entry.first)) {
+                    break;
+                }
+                place(position, heap_[best]);
+                position = best;
+            }
+            place(position, entry);
+        }
+    };
+
+    // Weighted adjacency lists in CSR form collected from a graph's edges. The reversed
+    // form lists incoming edges, which searches running against edge direction need;
+    // undirected graphs list every edge in both directions either way.
+    template <std::integral IDT, typename Weight>
+    class WeightedAdjacency {
+    private:
+        std::vector<size_t> offsets_;
+        std::vector<IDT> targets_;
+        std::vector<Weight> weights_;
+    public:
+        using IDType = IDT;
+        using WeightType = Weight;
+
+        WeightedAdjacency() : offsets_(1, 0), targets_{}, weights_{} {}
+
+        template <GraphEdge Graph>
+        requires EdgeWeight<typename Graph::EdgeType>
+        WeightedAdjacency(Graph& graph, bool reversed) : offsets_(graph.vertexCount() + 1, 0), targets_{}, weights_{} {
+            for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+                ++offsets_[static_cast<size_t>(reversed ? it->to() : it->from()) + 1];
+                if constexpr (!Graph::DIRECTED) {
+                    ++offsets_[static_cast<size_t>(reversed ? it->from() : it->to()) + 1];
+                }
+            }
+            for (size_t i = 1; i < offsets_.size(); ++i) {
+                offsets_[i] += offsets_[i - 1];
+            }
+
+            targets_.resize(offsets_.back());
+            weights_.resize(offsets_.back());
+            std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+            for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+                IDType from = reversed ? it->to() : it->from();
+                IDType to = reversed ? it->from() : it->to();
+                targets_[next[from]] = to;
+                weights_[next[from]++] = it->value.weight();
+                if constexpr (!Graph::DIRECTED) {
+                    targets_[next[to]] = from;
+                    weights_[next[to]++] = it->value.weight();
+                }
+            }
+        }
+
+        size_t vertexCount() const { return offsets_.size() - 1; }
+        size_t arcCount() const { return targets_.size(); }
+
+        size_t begin(size_t id) const { return offsets_[id]; }
+        size_t end(size_t id) const { return offsets_[id + 1]; }
+        IDType target(size_t arc) const { return targets_[arc]; }
+        Weight weight(size_t arc) const { return weights_[arc]; }
+    };
+
+    // Distances between k landmarks and every vertex, stored vertex-major (vertex * k + landmark)
+    // so one query reads two short contiguous rows. Directed graphs also keep the distances
+    // from every vertex to the landmarks. The triangle inequality turns them into distance
+    // bounds that need no search. Unreachable pairs are stored as the maximal weight.
+    template <typename Weight>
+    requires std::is_arithmetic_v<Weight>
+    class LandmarkTable {
+    private:
+        static constexpr std::uint64_t MAGIC = 0x314c42544c4753; // "SGLTBL1"
+
+        size_t vertexCount_;
+        bool directed_;
+        std::vector<size_t> landmarks_;
+        std::vector<Weight> from_;
+        std::vector<Weight> to_;
+
+        static Weight infinity() { return std::numeric_limits<Weight>::max(); }
+
+        template <typename T>
+        static void write(std::ostream& stream, const T* values, size_t count) {
+            stream.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+
+        template <typename T>
+        static bool read(std::istream& stream, T* values, size_t count) {
+            stream.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+            return static_cast<bool>(stream) && stream.gcount() == static_cast<std::streamsize>(count * sizeof(T));
+        }
+
+        // Grows values chunk by chunk as data arrives, so a corrupt count cannot allocate more
+        // than the stream holds.
+        template <typename T>
+        static bool read(std::istream& stream, std::vector<T>& values, size_t count) {
+            constexpr size_t CHUNK = (size_t{1} << 16) / sizeof(T) + 1;
+            values.clear();
+            while (values.size() < count) {
+                size_t size = values.size();
+                size_t chunk = std::min(count - size, CHUNK);
+                values.resize(size + chunk);
+                if (!read(stream, values.data() + size, chunk)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    public:
+        using WeightType = Weight;
+
+        LandmarkTable() : vertexCount_{0}, directed_{false}, landmarks_{}, from_{}, to_{} {}
+        LandmarkTable(size_t vertexCount, bool directed) :
+            vertexCount_{vertexCount}, directed_{directed}, landmarks_{}, from_{}, to_{} {}
+
+        // distFrom[v] is the distance landmark -> v, distTo[v] the distance v -> landmark;
+        // distTo is ignored for undirected tables.
+        void addLandmark(size_t landmark, const std::vector<Weight>& distFrom, const std::vector<Weight>& distTo) {
+            size_t k = landmarks_.size();
+            std::vector<Weight> from(vertexCount_ * (k + 1));
+            std::vector<Weight> to(directed_ ? vertexCount_ * (k + 1) : 0);
+            for (size_t v = 0; v < vertexCount_; ++v) {
+                std::copy(from_.begin() + v * k, from_.begin() + (v + 1) * k, from.begin() + v * (k + 1));
+                from[v * (k + 1) + k] = distFrom[v];
+                if (directed_) {
+                    std::copy(to_.begin() + v * k, to_.begin() + (v + 1) * k, to.begin() + v * (k + 1));
+                    to[v * (k + 1) + k] = distTo[v];
+                }
+            }
+            from_ = std::move(from);
+            to_ = std::move(to);
+            landmarks_.push_back(landmark);
+        }
+
+        size_t vertexCount() const { return vertexCount_; }
+        size_t landmarkCount() const { return landmarks_.size(); }
+        bool directed() const { return directed_; }
+        const std::vector<size_t>& landmarks() const { return landmarks_; }
+
+        Weight distFrom(size_t landmark, size_t vertex) const { return from_[vertex * landmarks_.size() + landmark]; }
+        Weight distTo(size_t landmark, size_t vertex) const {
+            return directed_ ? to_[vertex * landmarks_.size() + landmark] : distFrom(landmark, vertex);
+        }
+
+        // Never exceeds the distance from source to target; maxWeight if target is provably unreachable.
+        Weight lowerBound(size_t source, size_t target) const {
+            Weight bound = 0;
+            for (size_t l = 0; l < landmarks_.size(); ++l) {
+                Weight ls = distFrom(l, source);
+                Weight lt = distFrom(l, target);
+                if (ls != infinity()) {
+                    if (lt == infinity()) {
+                        return infinity();
+                    }
+                    bound = std::max(bound, lt > ls ? lt - ls : Weight{0});
+                }
+
+                Weight sl = distTo(l, source);
+                Weight tl = distTo(l, target);
+                if (tl != infinity()) {
+                    if (sl == infinity()) {
+                        return infinity();
+                    }
+                    bound = std::max(bound, sl > tl ? sl - tl : Weight{0});
+                }
+            }
+            return bound;
+        }
+
+        // Length of the shortest path through a landmark; maxWeight if none exists.
+        Weight upperBound(size_t source, size_t target) const {
+            Weight bound = infinity();
+            for (size_t l = 0; l < landmarks_.size(); ++l) {
+                Weight sl = distTo(l, source);
+                Weight lt = distFrom(l, target);
+                if (sl != infinity() && lt != infinity()) {
+                    bound = std::min<Weight>(bound, sl + lt);
+                }
+            }
+            return bound;
+        }
+
+        // Raw binary dump; only meant to be read back on a machine with the same layout.
+        bool save(std::ostream& stream) const {
+            std::uint64_t header[4] = {MAGIC, sizeof(Weight), vertexCount_, landmarks_.size()};
+            char directed = directed_ ? 1 : 0;
+            write(stream, header, 4);
+            write(stream, &directed, 1);
+            write(stream, landmarks_.data(), landmarks_.size());
+            write(stream, from_.data(), from_.size());
+            write(stream, to_.data(), to_.size());
+            return static_cast<bool>(stream);
+        }
+
+        // Leaves the table unchanged if the stream does not hold a complete, consistent table
+        // of this weight type. The header counts are not trusted for allocation.
+        bool load(std::istream& stream) {
+            std::uint64_t header[4];
+            char directed;
+            if (!read(stream, header, 4) || header[0] != MAGIC || header[1] != sizeof(Weight) ||
+                !read(stream, &directed, 1) || (directed != 0 && directed != 1)) {
+                return false;
+            }
+
+            constexpr std::uint64_t maxCount = std::numeric_limits<size_t>::max() / sizeof(Weight);
+            std::uint64_t n = header[2];
+            std::uint64_t k = header[3];
+            if (n > maxCount || k > maxCount || (k != 0 && n > maxCount / k) || (k != 0 && n == 0)) {
+                return false;
+            }
+
+            std::vector<size_t> landmarks = {};
+            std::vector<Weight> from = {};
+            std::vector<Weight> to = {};
+            if (!read(stream, landmarks, k) || !read(stream, from, n * k) || !read(stream, to, directed ? n * k : 0)) {
+                return false;
+            }
+            for (size_t landmark: landmarks) {
+                if (landmark >= n) {
+                    return false;
+                }
+            }
+
+            vertexCount_ = static_cast<size_t>(n);
+            directed_ = directed != 0;
+            landmarks_ = std::move(landmarks);
+            from_ = std::move(from);
+            to_ = std::move(to);
+            return true;
+        }
+    };
+
+    // Search graph of a contraction hierarchy: every vertex keeps the arcs to vertices of higher
+    // rank, outgoing ones for the forward search and incoming ones for the backward search.
+    // Shortcut arcs remember the contracted vertex they bypass, so paths can be unpacked.
+    // Queries reuse scratch space owned by the hierarchy and must not run concurrently.
+    template <std::integral IDT, typename Weight>
+    class ContractionHierarchy {
+    public:
+        using IDType = IDT;
+        using WeightType = Weight;
+        // Neighbour, weight and bypassed vertex (invalidID() for original edges).
+        using ArcType = std::tuple<IDT, Weight, IDT>;
+
+    private:
+        std::vector<size_t> rank_;
+        std::vector<size_t> upOffsets_;
+        std::vector<ArcType> upArcs_;
+        std::vector<size_t> downOffsets_;
+        std::vector<ArcType> downArcs_;
+
+        std::vector<Weight> dist_[2];
+        std::vector<IDT> prev_[2];
+        std::vector<IDT> touched_;
+        IndexedDaryHeap<Weight> queue_[2];
+
+        static Weight infinity() { return std::numeric_limits<Weight>::max(); }
+
+        static void flatten(const std::vector<std::vector<ArcType>>& lists, std::vector<size_t>& offsets,
+                            std::vector<ArcType>& arcs) {
+            offsets.assign(lists.size() + 1, 0);
+            for (size_t v = 0; v < lists.size(); ++v) {
+                offsets[v + 1] = offsets[v] + lists[v].size();
+            }
+            arcs.clear();
+            arcs.reserve(offsets.back());
+            for (const std::vector<ArcType>& list: lists) {
+                arcs.insert(arcs.end(), list.begin(), list.end());
+            }
+        }
+
+        void label(size_t side, IDT id, Weight dist, IDT prev) {
+            if (dist_[0][id] == infinity() && dist_[1][id] == infinity()) {
+                touched_.push_back(id);
+            }
+            dist_[side][id] = dist;
+            prev_[side][id] = prev;
+            queue_[side].pushOrDecrease(id, dist);
+        }
+
+        // Stall-on-demand: a vertex reached more cheaply through a higher neighbour, against
+        // the search direction, cannot lie on a shortest up-down path, so its arcs are skipped.
+        bool stalled(size_t side, IDT id) const {
+            const std::vector<size_t>& offsets = side == 0 ? downOffsets_ : upOffsets_;
+            const std::vector<ArcType>& arcs = side == 0 ? downArcs_ : upArcs_;
+            for (size_t arc = offsets[id]; arc < offsets[id + 1]; ++arc) {
+                Weight higher = dist_[side][std::get<0>(arcs[arc])];
+                if (higher != infinity() && higher + std::get<1>(arcs[arc]) < dist_[side][id]) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Upward search from both ends; returns the best meeting vertex or invalidID().
+        IDT search(size_t source, size_t target, Weight& best) {
+            for (IDT id: touched_) {
+                dist_[0][id] = dist_[1][id] = infinity();
+                prev_[0][id] = prev_[1][id] = invalidID<IDT>();
+            }
+            touched_.clear();
+            queue_[0].clear();
+            queue_[1].clear();
+
+            best = infinity();
+            IDT meeting = invalidID<IDT>();
+            label(0, static_cast<IDT>(source), Weight{0}, invalidID<IDT>());
+            label(1, static_cast<IDT>(target), Weight{0}, invalidID<IDT>());
+
+            while (true) {
+                Weight top0 = queue_[0].empty() ? infinity() : queue_[0].topPriority();
+                Weight top1 = queue_[1].empty() ? infinity() : queue_[1].topPriority();
+                if (std::min(top0, top1) >= best) {
+                    break;
+                }
+
+                size_t side = top0 <= top1 ? 0 : 1;
+                IDT id = static_cast<IDT>(queue_[side].top());
+                queue_[side].pop();
+                if (dist_[1 - side][id] != infinity() && dist_[side][id] + dist_[1 - side][id] < best) {
+                    best = dist_[side][id] + dist_[1 - side][id];
+                    meeting = id;
+                }
+
+                const std::vector<size_t>& offsets = side == 0 ? upOffsets_ : downOffsets_;
+                const std::vector<ArcType>& arcs = side == 0 ? upArcs_ : downArcs_;
+                if (stalled(side, id)) {
+                    continue;
+                }
+                for (size_t arc = offsets[id]; arc < offsets[id + 1]; ++arc) {
+                    IDT next = std::get<0>(arcs[arc]);
+                    Weight candidate = dist_[side][id] + std::get<1>(arcs[arc]);
+                    if (candidate < dist_[side][next]) {
+                        label(side, next, candidate, id);
+                    }
+                }
+            }
+
+            return meeting;
+        }
+
+        // The arc from -> to is stored at the endpoint of lower rank.
+        const ArcType& arcBetween(IDT from, IDT to) const {
+            if (rank_[to] > rank_[from]) {
+                for (size_t arc = upOffsets_[from]; arc < upOffsets_[from + 1]; ++arc) {
+                    if (std::get<0>(upArcs_[arc]) == to) {
+                        return upArcs_[arc];
+                    }
+                }
+            }
+            size_t arc = downOffsets_[to];
+            while (std::get<0>(downArcs_[arc]) != from) {
+                ++arc;
+            }
+            return downArcs_[arc];
+        }
+
+    public:
+        ContractionHierarchy() : rank_{}, upOffsets_(1, 0), upArcs_{}, downOffsets_(1, 0), downArcs_{},
+                                 dist_{}, prev_{}, touched_{}, queue_{} {}
+
+        // rank[v] is the contraction order of v; up[v] lists arcs v -> x and down[v] arcs x -> v,
+        // all with rank[x] > rank[v].
+        ContractionHierarchy(std::vector<size_t> rank, const std::vector<std::vector<ArcType>>& up,
+                             const std::vector<std::vector<ArcType>>& down) :
+                rank_(std::move(rank)), upOffsets_{}, upArcs_{}, downOffsets_{}, downArcs_{},
+                dist_{std::vector<Weight>(rank_.size(), infinity()), std::vector<Weight>(rank_.size(), infinity())},
+                prev_{std::vector<IDT>(rank_.size(), invalidID<IDT>()), std::vector<IDT>(rank_.size(), invalidID<IDT>())},
+                touched_{}, queue_{IndexedDaryHeap<Weight>(rank_.size()), IndexedDaryHeap<Weight>(rank_.size())} {
+            flatten(up, upOffsets_, upArcs_);
+            flatten(down, downOffsets_, downArcs_);
+        }
+
+        size_t vertexCount() const { return rank_.size(); }
+        size_t arcCount() const { return upArcs_.size() + downArcs_.size(); }
+        size_t rank(size_t vertex) const { return rank_[vertex]; }
+
+        // maxWeight if target is unreachable.
+        Weight distance(size_t source, size_t target) {
+            Weight best;
+            search(source, target, best);
+            return best;
+        }
+
+        // Distance and vertex IDs of the path with all shortcuts unpacked; empty if unreachable.
+        std::pair<Weight, std::vector<IDT>> shortestPath(size_t source, size_t target) {
+            Weight best;
+            IDT meeting = search(source, target, best);
+            std::vector<IDT> path = {};
+            if (meeting == invalidID<IDT>()) {
+                return std::pair(best, path);
+            }
+
+            std::vector<IDT> chain = {};
+            for (IDT id = meeting; id != invalidID<IDT>(); id = prev_[0][id]) {
+                chain.push_back(id);
+            }
+            std::reverse(chain.begin(), chain.end());
+            for (IDT id = prev_[1][meeting]; id != invalidID<IDT>(); id = prev_[1][id]) {
+                chain.push_back(id);
+            }
+
+            path.push_back(chain.front());
+            std::vector<std::pair<IDT, IDT>> stack = {};
+            for (size_t i = chain.size() - 1; i > 0; --i) {
+                stack.emplace_back(chain[i - 1], chain[i]);
+            }
+            while (!stack.empty()) {
+                auto [from, to] = stack.back();
+                stack.pop_back();
+                IDT middle = std::get<2>(arcBetween(from, to));
+                if (middle == invalidID<IDT>()) {
+                    path.push_back(to);
+                } else {
+                    stack.emplace_back(middle, to);
+                    stack.emplace_back(from, middle);
+                }
+            }
+
+            return std::pair(best, path);
+        }
+    };
+
+    // All-pairs distances in one row-major array with a matching array of 32-bit successors:
+    // next(i, j) is the vertex after i on a shortest path to j. Missing paths are stored as
+    // infinity(), which for integral weights is half the maximum so that adding two of them
+    // cannot overflow.
+    template <typename Weight>
+    requires std::is_arithmetic_v<Weight>
+    class DistanceMatrix {
+    private:
+        size_t size_;
+        std::vector<Weight> dist_;
+        std::vector<std::uint32_t> next_;
+    public:
+        using WeightType = Weight;
+        static constexpr std::uint32_t NO_VERTEX = std::numeric_limits<std::uint32_t>::max();
+
+        static constexpr Weight infinity() {
+            if constexpr (std::numeric_limits<Weight>::has_infinity) {
+                return std::numeric_limits<Weight>::infinity();
+            } else {
+                return std::numeric_limits<Weight>::max() / 2;
+            }
+        }
+
+        DistanceMatrix() : size_{0}, dist_{}, next_{} {}
+        explicit DistanceMatrix(size_t size) : size_{size}, dist_(size * size, infinity()), next_(size * size, NO_VERTEX) {
+            for (size_t i = 0; i < size; ++i) {
+                dist_[i * size + i] = Weight{0};
+                next_[i * size + i] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        size_t size() const { return size_; }
+
+        Weight& distance(size_t from, size_t to) { return dist_[from * size_ + to]; }
+        Weight distance(size_t from, size_t to) const { return dist_[from * size_ + to]; }
+        std::uint32_t& next(size_t from, size_t to) { return next_[from * size_ + to]; }
+        std::uint32_t next(size_t from, size_t to) const { return next_[from * size_ + to]; }
+        bool reachable(size_t from, size_t to) const { return distance(from, to) < infinity(); }
+
+        Weight* distanceData() { return dist_.data(); }
+        std::uint32_t* nextData() { return next_.data(); }
+
+        // Vertices of a shortest path from -> to, both included; empty if there is none.
+        std::vector<std::uint32_t> path(size_t from, size_t to) const {
+            std::vector<std::uint32_t> vertices = {};
+            if (!reachable(from, to)) {
+                return vertices;
+            }
+            vertices.push_back(static_cast<std::uint32_t>(from));
+            while (from != to) {
+                from = next(from, to);
+                vertices.push_back(static_cast<std::uint32_t>(from));
+            }
+            return vertices;
+        }
+    };
+
     template <typename Weight>
     class WeightValue {
     private:
@@ -72,16 +819,20 @@ namespace sgl {
         Edge<IDT, ValueFlow>* reverse_;
         Flow capacity_;
         Flow flow_;
+        bool isReverse_;
     public:
         using FlowType = Flow;
         using EdgeType = Edge<IDT, ValueFlow>;
 
-        ValueFlow(Flow capacity) : reverse_{nullptr}, capacity_{capacity}, flow_{zeroFlow()} {}
+        ValueFlow(Flow capacity) : reverse_{nullptr}, capacity_{capacity}, flow_{zeroFlow()}, isReverse_{false} {}
 
         Flow capacity() { return capacity_; }
+        void capacity(Flow capacity) { capacity_ = capacity; }
         Flow flow() { return flow_; }
         void flow(Flow flow) { flow_ = flow; }
         EdgeType* reverse() { return reverse_; }
+        // True for the zero-capacity residual edges added by insertFlowEdges.
+        bool isReverse() { return isReverse_; }
 
         static Flow zeroFlow() { return 0; }
         static Flow maxFlow() { return std::numeric_limits<FlowType>::max(); }
@@ -103,36 +854,408 @@ namespace sgl {
                 EdgeType& reverse = *it;
                 forward.value.reverse_ = &reverse;
                 reverse.value.reverse_ = &forward;
+                reverse.value.isReverse_ = true;
             }
         }
     };
 
-    template <typename Data, typename Flag>
-    class VectorVertex {
-    private:
-        std::vector<VectorVertex<Data, Flag>*> vertices_;
+    // Union-find over the IDs 0..size-1 with union by size and path halving.
+    template <std::integral IDType>
+    class DisjointSets {
     public:
-        Flag flags;
-        Data data;
-        using ThisType = VectorVertex<Data, Flag>;
-        using ContainerType = std::vector<ThisType*>;
-        using FlagType = Flag;
-
-        class iterator {
-        public:
-            using iterator_category = std::forward_iterator_tag;
-            using difference_type   = std::ptrdiff_t;
-            using value_type        = VectorVertex<Data, Flag>;
-            using pointer           = value_type*;
-            using reference         = value_type&;
+        explicit DisjointSets(size_t size) : parent_(size), size_(size, 1), setCount_{size} {
+            for (size_t i = 0; i < size; ++i) {
+                parent_[i] = static_cast<IDType>(i);
+            }
+        }
 
-            iterator () : it_{} {}
-            explicit iterator(typename ContainerType::iterator it) : it_(it) {}
+        IDType find(IDType id) {
+            while (parent_[id] != id) {
+                parent_[id] = parent_[parent_[id]];
+                id = parent_[id];
+            }
+            return id;
+        }
 
-            reference operator*() const { return *(*it_); }
-            pointer operator->() { return *it_; }
+        // Walks to the root without compressing, so threads may call it concurrently as long
+        // as none of them unites sets at the same time.
+        IDType representative(IDType id) const {
+            while (parent_[id] != id) {
+                id = parent_[id];
+            }
+            return id;
+        }
 
-            iterator& operator++() { it_++; return *this; }
+        // Returns false if both IDs already were in the same set.
+        bool unite(IDType a, IDType b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return false;
+            }
+            if (size_[a] < size_[b]) {
+                std::swap(a, b);
+            }
+            parent_[b] = a;
+            size_[a] += size_[b];
+            --setCount_;
+            return true;
+        }
+
+        // Appends a singleton set and returns its ID.
+        IDType addElement() {
+            IDType id = static_cast<IDType>(parent_.size());
+            parent_.push_back(id);
+            size_.push_back(1);
+            ++setCount_;
+            return id;
+        }
+
+        bool connected(IDType a, IDType b) { return find(a) == find(b); }
+        size_t setSize(IDType id) { return size_[find(id)]; }
+        size_t size() const { return parent_.size(); }
+        size_t setCount() const { return setCount_; }
+
+    private:
+        std::vector<IDType> parent_;
+        std::vector<size_t> size_;
+        size_t setCount_;
+    };
+
+    // Result of biconnectedComponents(). Blocks are numbered per adjacency entry: the entry k
+    // of vertex v is arcBlocks[arcOffsets[v] + k], and both directions of an edge share it.
+    // Self-loops belong to no block.
+    template <std::integral IDType>
+    struct BiconnectedComponents {
+        static constexpr size_t NO_BLOCK = std::numeric_limits<size_t>::max();
+
+        std::vector<IDType> cutVertices = {};
+        std::vector<std::pair<IDType, IDType>> bridges = {};
+        std::vector<size_t> arcOffsets = {};
+        std::vector<size_t> arcBlocks = {};
+        size_t blockCount = 0;
+
+        size_t block(IDType vertex, size_t arc) const { return arcBlocks[arcOffsets[vertex] + arc]; }
+    };
+
+    // Frames of an iterative depth first traversal: a vertex and the next neighbour to visit.
+    // Reserving it for the expected depth and reusing it avoids reallocations between searches.
+    template <IsVertex Vertex>
+    class DepthFirstStack {
+    public:
+        using FrameType = std::pair<Vertex*, typename Vertex::VertexIterator>;
+
+        DepthFirstStack() : frames_{} {}
+        explicit DepthFirstStack(size_t capacity) : frames_{} { frames_.reserve(capacity); }
+
+        void push(Vertex& vertex) { frames_.emplace_back(&vertex, vertex.vertexBegin()); }
+        void pop() { frames_.pop_back(); }
+        FrameType& top() { return frames_.back(); }
+
+        bool empty() const { return frames_.empty(); }
+        size_t size() const { return frames_.size(); }
+        void reserve(size_t capacity) { frames_.reserve(capacity); }
+        void clear() { frames_.clear(); }
+
+    private:
+        std::vector<FrameType> frames_;
+    };
+
+    // Scratch space of updateCapacities(). Marks are epoch stamps, so a caller that keeps one
+    // instance per network pays for allocation once and afterwards only for the vertices its
+    // searches reach.
+    template <typename Edge>
+    struct FlowRepairBuffers {
+        EpochVisitMap forwardSeen = {};
+        EpochVisitMap backwardSeen = {};
+        // Vertices proven unreachable from source, or unable to reach target, since the last
+        // augmentation.
+        EpochVisitMap noSource = {};
+        EpochVisitMap noTarget = {};
+        EpochVisitMap onPath = {};
+        std::vector<Edge*> forwardLink = {};
+        std::vector<Edge*> backwardLink = {};
+        std::vector<size_t> position = {};
+        std::vector<size_t> queue = {};
+        std::vector<Edge*> path = {};
+        std::vector<Edge*> simplePath = {};
+        // Arcs whose residual capacity grew since the flow was last known to be maximal.
+        std::vector<Edge*> touched = {};
+
+        void resize(size_t size) {
+            if (forwardLink.size() == size) {
+                return;
+            }
+            forwardSeen.resize(size);
+            backwardSeen.resize(size);
+            noSource.resize(size);
+            noTarget.resize(size);
+            onPath.resize(size);
+            forwardLink.assign(size, nullptr);
+            backwardLink.assign(size, nullptr);
+            position.assign(size, 0);
+        }
+    };
+
+    // Fixed set of worker threads for fork-join loops. The calling thread takes part as
+    // thread 0, so a pool of one thread runs everything inline. Calls must not be nested
+    // or issued from several threads at once.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency()) :
+            workers_{}, mutex_{}, start_{}, done_{}, task_{}, generation_{0}, pending_{0}, stop_{false} {
+            for (size_t thread = 1; thread < std::max<size_t>(threadCount, 1); ++thread) {
+                workers_.emplace_back([this, thread]() { work(thread); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            start_.notify_all();
+            for (std::thread& worker: workers_) {
+                worker.join();
+            }
+        }
+
+        size_t threadCount() const { return workers_.size() + 1; }
+
+        // Runs callable(thread) once on every thread and waits for all of them.
+        template <typename Callable>
+        requires std::invocable<Callable, size_t>
+        void runOnEachThread(const Callable& callable) {
+            if (workers_.empty()) {
+                std::invoke(callable, size_t{0});
+                return;
+            }
+
+            {
+                std::lock_guard lock(mutex_);
+                task_ = [&callable](size_t thread) { std::invoke(callable, thread); };
+                pending_ = workers_.size();
+                ++generation_;
+            }
+            start_.notify_all();
+
+            std::invoke(callable, size_t{0});
+
+            std::unique_lock lock(mutex_);
+            done_.wait(lock, [this]() { return pending_ == 0; });
+            task_ = nullptr;
+        }
+
+        // Calls callable(index, thread) for every index in [begin, end); threads claim
+        // chunks of grain indices as they go.
+        template <typename Callable>
+        requires std::invocable<Callable, size_t, size_t>
+        void parallelFor(size_t begin, size_t end, const Callable& callable, size_t grain = 1024) {
+            if (begin >= end) {
+                return;
+            }
+            grain = std::max<size_t>(grain, 1);
+
+            std::atomic<size_t> next = begin;
+            runOnEachThread([&next, end, grain, &callable](size_t thread) {
+                for (size_t first = next.fetch_add(grain); first < end; first = next.fetch_add(grain)) {
+                    size_t last = std::min(first + grain, end);
+                    for (size_t index = first; index < last; ++index) {
+                        std::invoke(callable, index, thread);
+                    }
+                }
+            });
+        }
+
+    private:
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable start_;
+        std::condition_variable done_;
+        std::function<void(size_t)> task_;
+        size_t generation_;
+        size_t pending_;
+        bool stop_;
+
+        void work(size_t thread) {
+            size_t seen = 0;
+            while (true) {
+                {
+                    std::unique_lock lock(mutex_);
+                    start_.wait(lock, [this, seen]() { return stop_ || generation_ != seen; });
+                    if (stop_) {
+                        return;
+                    }
+                    seen = generation_;
+                }
+
+                task_(thread);
+
+                std::lock_guard lock(mutex_);
+                if (--pending_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    };
+
+    struct EdgeLoadOptions {
+        bool sortNeighbors = false;
+        bool removeDuplicates = false;
+        bool removeSelfLoops = false;
+    };
+
+    // Marks the first occurrence of every endpoint pair in an edge list. Edges are grouped by
+    // their smaller (or, if directed, source) endpoint, so undirected duplicates match in
+    // either orientation.
+    template <IsEdge Edge, bool Directed, std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+    std::vector<bool> uniqueEdgeMask(Iterator begin, Sentinel end, size_t vertexCount) {
+        using IDType = typename Edge::IDType;
+
+        auto key = [](Edge& edge) { return Directed ? edge.from() : std::min(edge.from(), edge.to()); };
+        auto other = [](Edge& edge) { return Directed ? edge.to() : std::max(edge.from(), edge.to()); };
+
+        std::vector<size_t> offsets(vertexCount + 1, 0);
+        size_t count = 0;
+        for (Iterator it = begin; it != end; ++it, ++count) {
+            Edge edge(*it);
+            ++offsets[static_cast<size_t>(key(edge)) + 1];
+        }
+        for (size_t i = 1; i < offsets.size(); ++i) {
+            offsets[i] += offsets[i - 1];
+        }
+
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        std::vector<std::pair<IDType, size_t>> rows(count);
+        size_t index = 0;
+        for (Iterator it = begin; it != end; ++it, ++index) {
+            Edge edge(*it);
+            rows[next[key(edge)]++] = std::pair(other(edge), index);
+        }
+
+        std::vector<bool> keep(count, false);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            std::sort(rows.begin() + offsets[v], rows.begin() + offsets[v + 1]);
+            for (size_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+                if (i == offsets[v] || std::get<0>(rows[i]) != std::get<0>(rows[i - 1])) {
+                    keep[std::get<1>(rows[i])] = true;
+                }
+            }
+        }
+
+        return keep;
+    }
+
+    // Serves allocations from large slabs and frees them all at once on destruction.
+    // Deallocation is a no-op, so storage dropped by a growing container is only
+    // reclaimed together with the arena.
+    class MonotonicArena {
+    private:
+        std::vector<std::unique_ptr<std::byte[]>> slabs_;
+        std::byte* current_;
+        size_t remaining_;
+        size_t slabSize_;
+        size_t allocated_;
+
+        void addSlab(size_t size) {
+            slabs_.push_back(std::make_unique<std::byte[]>(size));
+            current_ = slabs_.back().get();
+            remaining_ = size;
+            allocated_ += size;
+        }
+
+        static size_t padding(const std::byte* ptr, size_t alignment) {
+            return (alignment - reinterpret_cast<std::uintptr_t>(ptr) % alignment) % alignment;
+        }
+
+    public:
+        explicit MonotonicArena(size_t slabSize = size_t{1} << 20) :
+            slabs_{}, current_{nullptr}, remaining_{0}, slabSize_{slabSize}, allocated_{0} {}
+
+        MonotonicArena(const MonotonicArena&) = delete;
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        void* allocate(size_t bytes, size_t alignment) {
+            if (current_ == nullptr || padding(current_, alignment) + bytes > remaining_) {
+                addSlab(std::max(slabSize_, bytes + alignment));
+            }
+
+            size_t pad = padding(current_, alignment);
+            void* result = current_ + pad;
+            current_ += pad + bytes;
+            remaining_ -= pad + bytes;
+            return result;
+        }
+
+        void release() {
+            slabs_.clear();
+            current_ = nullptr;
+            remaining_ = 0;
+            allocated_ = 0;
+        }
+
+        size_t allocatedBytes() const { return allocated_; }
+    };
+
+    template <typename T>
+    class ArenaAllocator {
+    private:
+        MonotonicArena* arena_;
+
+        template <typename U>
+        friend class ArenaAllocator;
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_{&arena} {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_{other.arena_} {}
+
+        T* allocate(size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) noexcept {}
+
+        MonotonicArena& arena() const { return *arena_; }
+
+        template <typename U>
+        bool operator== (const ArenaAllocator<U>& other) const { return arena_ == other.arena_; }
+    };
+
+    template <typename Data, typename Flag, typename Allocator = std::allocator<void>>
+    class VectorVertex {
+    private:
+        std::vector<VectorVertex<Data, Flag, Allocator>*,
+                    typename std::allocator_traits<Allocator>::template rebind_alloc<VectorVertex<Data, Flag, Allocator>*>>
+                    vertices_;
+    public:
+        Flag flags;
+        Data data;
+        using ThisType = VectorVertex<Data, Flag, Allocator>;
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<ThisType*>;
+        using ContainerType = std::vector<ThisType*, allocator_type>;
+        using FlagType = Flag;
+
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = VectorVertex<Data, Flag, Allocator>;
+            using pointer           = value_type*;
+            using reference         = value_type&;
+
+            iterator () : it_{} {}
+            explicit iterator(typename ContainerType::iterator it) : it_(it) {}
+
+            reference operator*() const { return *(*it_); }
+            pointer operator->() { return *it_; }
+
+            iterator& operator++() { it_++; return *this; }
 
             iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
 
@@ -146,65 +1269,1084 @@ namespace sgl {
 
         VectorVertex() : vertices_{}, flags{}, data{} {}
         explicit VectorVertex(const Data& d) : vertices_{}, flags{}, data(d) {}
-        VectorVertex(const VectorVertex& v) : vertices_{}, flags(v.flags), data(v.data) {}
+        VectorVertex(const VectorVertex& v) :
+            vertices_(std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                v.vertices_.get_allocator())), flags(v.flags), data(v.data) {}
         VectorVertex(VectorVertex&& v)  noexcept = default;
 
         template <typename... Args>
         requires std::constructible_from<Data, Args...>
         explicit VectorVertex(Args&&... args) : vertices_{},flags{}, data{args...} {}
 
+        VectorVertex(std::allocator_arg_t, const allocator_type& alloc) : vertices_(alloc), flags{}, data{} {}
+        VectorVertex(std::allocator_arg_t, const allocator_type& alloc, const VectorVertex& v) :
+            vertices_(alloc), flags(v.flags), data(v.data) {}
+
+        template <typename... Args>
+        requires std::constructible_from<Data, Args...>
+        VectorVertex(std::allocator_arg_t, const allocator_type& alloc, Args&&... args) :
+            vertices_(alloc), flags{}, data{args...} {}
+
         VectorVertex& operator=(const VectorVertex& v) {
             if (this == &v)
                 return *this;
 
-            vertices_ = {};
-            flags = v.flags;
-            data = v.data;
+            vertices_ = ContainerType(vertices_.get_allocator());
+            flags = v.flags;
+            data = v.data;
+
+            return *this;
+        }
+
+        VectorVertex& operator=(VectorVertex&& v)  noexcept = default;
+
+        void addEdge(ThisType& to) {
+            vertices_.push_back(&to);
+        }
+
+        void reserve(size_t capacity) {
+            vertices_.reserve(capacity);
+        }
+
+        size_t degree() const { return vertices_.size(); }
+
+        void sortEdges() {
+            std::sort(vertices_.begin(), vertices_.end(), [](const ThisType* a, const ThisType* b) {
+                return a->flags.id < b->flags.id;
+            });
+        }
+
+        // Drops repeated neighbours; expects the adjacency to be sorted. An undirected
+        // self-loop is stored as two entries, so keepLoopPair leaves both in place.
+        void uniqueEdges(bool keepLoopPair = false) {
+            vertices_.erase(std::unique(vertices_.begin(), vertices_.end()), vertices_.end());
+            if (keepLoopPair) {
+                auto loop = std::find(vertices_.begin(), vertices_.end(), this);
+                if (loop != vertices_.end()) {
+                    vertices_.insert(loop, this);
+                }
+            }
+        }
+
+        void reset() {
+            flags.reset();
+        }
+
+        iterator vertexBegin() { return iterator(vertices_.begin()); }
+        iterator vertexEnd() { return iterator(vertices_.end()); }
+    };
+
+    template <typename Data, typename Flag, typename Edge, typename Allocator = std::allocator<void>>
+    class VectorEdgeVertex {
+    private:
+        std::vector<std::pair<VectorEdgeVertex<Data, Flag, Edge, Allocator>*, Edge*>,
+                    typename std::allocator_traits<Allocator>::template rebind_alloc<
+                        std::pair<VectorEdgeVertex<Data, Flag, Edge, Allocator>*, Edge*>>> vertices_;
+    public:
+        Flag flags;
+        Data data;
+        using ThisType = VectorEdgeVertex<Data, Flag, Edge, Allocator>;
+        using PairType = std::pair<ThisType*, Edge*>;
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<PairType>;
+        using ContainerType = std::vector<PairType, allocator_type>;
+        using FlagType = Flag;
+        using EdgeType = Edge;
+        using PairIterator = typename ContainerType::iterator;
+
+        class iterator {
+        protected:
+            iterator () : it_{} {}
+            explicit iterator(typename ContainerType::iterator it) : it_(it) {}
+
+        public:
+            friend bool operator== (const iterator& a, const iterator& b) { return a.it_ == b.it_; };
+            friend bool operator!= (const iterator& a, const iterator& b) { return a.it_ != b.it_; };
+        protected:
+            typename ContainerType::iterator it_;
+        };
+
+        class VertexIterator : public ThisType::iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = ThisType;
+            using pointer           = value_type*;
+            using reference         = value_type&;
+
+            VertexIterator() : iterator() {}
+            explicit VertexIterator(typename ContainerType::iterator it) : iterator(it) {}
+
+            reference operator*() const { return *std::get<0>(*this->it_); }
+            pointer operator->() { return std::get<0>(*this->it_); }
+
+            VertexIterator& operator++() { this->it_++; return *this; }
+            VertexIterator operator++(int) { VertexIterator tmp = *this; ++(*this); return tmp; }
+        };
+
+        class EdgeIterator : public ThisType::iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = Edge;
+            using pointer           = value_type*;
+            using reference         = value_type&;
+
+            EdgeIterator() : iterator() {}
+            explicit EdgeIterator(typename ContainerType::iterator it) : iterator(it) {}
+
+            reference operator*() const { return *std::get<1>(*this->it_); }
+            pointer operator->() { return std::get<1>(*this->it_); }
+
+            EdgeIterator& operator++() { this->it_++; return *this; }
+            EdgeIterator operator++(int) { EdgeIterator tmp = *this; ++(*this); return tmp; }
+        };
+
+        VectorEdgeVertex() : vertices_{}, flags{}, data{} {}
+        explicit VectorEdgeVertex(const Data& d) : vertices_{}, flags{}, data(d) {}
+        VectorEdgeVertex(const VectorEdgeVertex& v) :
+            vertices_(std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                v.vertices_.get_allocator())), flags(v.flags), data(v.data) {}
+        VectorEdgeVertex(VectorEdgeVertex&& v)  noexcept = default;
+
+        template <typename... Args>
+        requires std::constructible_from<Data, Args...>
+        explicit VectorEdgeVertex(Args&&... args) : vertices_{}, flags{}, data{args...} {}
+
+        VectorEdgeVertex(std::allocator_arg_t, const allocator_type& alloc) : vertices_(alloc), flags{}, data{} {}
+        VectorEdgeVertex(std::allocator_arg_t, const allocator_type& alloc, const VectorEdgeVertex& v) :
+            vertices_(alloc), flags(v.flags), data(v.data) {}
+
+        template <typename... Args>
+        requires std::constructible_from<Data, Args...>
+        VectorEdgeVertex(std::allocator_arg_t, const allocator_type& alloc, Args&&... args) :
+            vertices_(alloc), flags{}, data{args...} {}
+
+        VectorEdgeVertex& operator=(const VectorEdgeVertex& v) {
+            if (this == &v)
+                return *this;
+
+            vertices_ = ContainerType(vertices_.get_allocator());
+            flags = v.flags;
+            data = v.data;
+
+            return *this;
+        }
+
+        VectorEdgeVertex& operator=(VectorEdgeVertex&& v)  noexcept = default;
+
+        void addEdge(ThisType& vertex, Edge& edge) {
+            vertices_.push_back(std::pair(&vertex, &edge));
+        }
+
+        void reserve(size_t capacity) {
+            vertices_.reserve(capacity);
+        }
+
+        size_t degree() const { return vertices_.size(); }
+
+        void sortEdges() {
+            std::stable_sort(vertices_.begin(), vertices_.end(), [](const PairType& a, const PairType& b) {
+                return std::get<0>(a)->flags.id < std::get<0>(b)->flags.id;
+            });
+        }
+
+        void reset() {
+            flags.reset();
+        }
+
+        VertexIterator vertexBegin() { return VertexIterator(vertices_.begin()); }
+        VertexIterator vertexEnd() { return VertexIterator(vertices_.end()); }
+
+        EdgeIterator edgeBegin() { return EdgeIterator(vertices_.begin()); }
+        EdgeIterator edgeEnd() { return EdgeIterator(vertices_.end()); }
+
+        PairIterator pairBegin() { return vertices_.begin(); }
+        PairIterator pairEnd() { return vertices_.end(); }
+    };
+
+	template <VertexID Vertex, bool Directed, typename Allocator = std::allocator<Vertex>>
+	requires std::convertible_to<typename Vertex::FlagType::IDType, size_t>
+	class RandomAccessGraph {
+		public:
+        using AllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<Vertex>;
+		using VertexIterator = typename std::deque<Vertex, AllocatorType>::iterator;
+        using VertexType = Vertex;
+        using IDType = typename Vertex::FlagType::IDType;
+        static constexpr bool DIRECTED = Directed;
+		
+		RandomAccessGraph() : vertices_{} {}
+        explicit RandomAccessGraph(const Allocator& allocator) : vertices_(allocator) {}
+        RandomAccessGraph(const RandomAccessGraph& g) :
+            vertices_(std::allocator_traits<AllocatorType>::select_on_container_copy_construction(
+                g.vertices_.get_allocator())) {
+            addVertices(g.vertexBegin(), g.vertexEnd());
+            copyEdges(g);
+        }
+
+        RandomAccessGraph(RandomAccessGraph&& g) noexcept = default;
+
+        RandomAccessGraph& operator=(const RandomAccessGraph& g) {
+            if (this == &g)
+                return *this;
+
+            vertices_.clear();
+            addVertices(g.vertexBegin(), g.vertexEnd());
+            copyEdges(g);
+
+            return *this;
+        }
+
+        RandomAccessGraph& operator=(RandomAccessGraph&& g)  noexcept = default;
+
+        Vertex& operator[] (size_t pos) { return vertices_[pos]; }
+        const Vertex& operator[] (size_t pos) const { return vertices_[pos]; }
+
+		void addVertex(const Vertex& vertex) { emplaceVertex(vertex); }
+
+        template <typename... Args>
+        requires std::constructible_from<Vertex, Args...>
+        void addVertex(Args&&... args) {
+            emplaceVertex(args...);
+            vertices_.back().flags.id = vertices_.size() - 1;
+        }
+		
+		template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::constructible_from<Vertex, typename Iterator::reference>
+		void addVertices(Iterator begin, Sentinel end) {
+			while (begin != end) {
+				addVertex(*begin);
+				++begin;
+			}
+		}
+
+        void addEdge(IDType from, IDType to) {
+            vertices_[from].addEdge(vertices_[to]);
+            if constexpr (!DIRECTED) {
+                vertices_[to].addEdge(vertices_[from]);
+            }
+        }
+
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::same_as<std::pair<IDType, IDType>, typename Iterator::value_type>
+        void addEdges(Iterator begin, Sentinel end) {
+            while (begin != end) {
+                addEdge(std::get<0>(*begin), std::get<1>(*begin));
+                ++begin;
+            }
+        }
+
+        // Bulk version of addEdges: counts degrees first so every adjacency vector is
+        // allocated exactly once. Sorting and deduplication apply to whole adjacency lists.
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::same_as<std::pair<IDType, IDType>, typename Iterator::value_type>
+        void loadEdges(Iterator begin, Sentinel end, const EdgeLoadOptions& options = {}) {
+            std::vector<size_t> degrees(vertices_.size(), 0);
+            for (Iterator it = begin; it != end; ++it) {
+                IDType from = std::get<0>(*it);
+                IDType to = std::get<1>(*it);
+                if (options.removeSelfLoops && from == to) {
+                    continue;
+                }
+                ++degrees[from];
+                if constexpr (!DIRECTED) {
+                    ++degrees[to];
+                }
+            }
+
+            for (size_t i = 0; i < vertices_.size(); ++i) {
+                vertices_[i].reserve(vertices_[i].degree() + degrees[i]);
+            }
+
+            for (Iterator it = begin; it != end; ++it) {
+                if (!options.removeSelfLoops || std::get<0>(*it) != std::get<1>(*it)) {
+                    addEdge(std::get<0>(*it), std::get<1>(*it));
+                }
+            }
+
+            if (options.sortNeighbors || options.removeDuplicates) {
+                for (Vertex& vertex: vertices_) {
+                    vertex.sortEdges();
+                    if (options.removeDuplicates) {
+                        vertex.uniqueEdges(!DIRECTED);
+                    }
+                }
+            }
+        }
+
+        template <GraphID Graph>
+        void copyEdges(const Graph& g) {
+            for (auto from = g.vertexBegin(); from != g.vertexEnd(); ++from) {
+                for (auto to = from->vertexBegin(); to != from->vertexEnd(); ++to) {
+                    vertices_[from->flags.id].addEdge(vertices_[to->flags.id]);
+                }
+            }
+        }
+		
+		void reset() {
+            if (epoch_.advance()) {
+                return;
+            }
+			for (Vertex& vertex: vertices_) {
+				vertex.reset();
+			}
+		}
+
+        size_t vertexCount() {
+            return vertices_.size();
+        }
+
+		VertexIterator vertexBegin() { return vertices_.begin(); }
+		VertexIterator vertexEnd() { return vertices_.end(); }
+
+		private:
+		std::deque<Vertex, AllocatorType> vertices_;
+        GraphEpoch<typename Vertex::FlagType> epoch_;
+
+        // Allocator-aware vertices take their adjacency storage from the graph's allocator.
+        template <typename... Args>
+        void emplaceVertex(Args&&... args) {
+            if constexpr (std::uses_allocator_v<Vertex, AllocatorType>) {
+                vertices_.emplace_back(std::allocator_arg, vertices_.get_allocator(), args...);
+            } else {
+                vertices_.emplace_back(args...);
+            }
+            epoch_.bind(vertices_.back().flags);
+        }
+	};
+
+    // Undirected graph that keeps a union-find of its components up to date as vertices and
+    // edges are added, so connected() and componentOf() need no traversal. Components are
+    // named by a representative vertex, which may change as they merge. Edges can only be
+    // added; the index does not follow removals.
+    template <typename Graph>
+    requires GraphID<Graph> &&
+             GraphUndirected<Graph> &&
+             std::integral<typename Graph::IDType>
+    class IncrementalConnectivityGraph {
+    public:
+        using GraphType = Graph;
+        using IDType = typename Graph::IDType;
+        using VertexType = typename Graph::VertexType;
+        using VertexIterator = typename Graph::VertexIterator;
+        static constexpr bool DIRECTED = Graph::DIRECTED;
+
+        IncrementalConnectivityGraph() : graph_(), components_(0) {}
+
+        template <typename... Args>
+        void addVertex(Args&&... args) {
+            graph_.addVertex(std::forward<Args>(args)...);
+            components_.addElement();
+        }
+
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        void addVertices(Iterator begin, Sentinel end) {
+            while (begin != end) {
+                addVertex(*begin);
+                ++begin;
+            }
+        }
+
+        void addEdge(IDType from, IDType to) {
+            graph_.addEdge(from, to);
+            components_.unite(from, to);
+        }
+
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::same_as<std::pair<IDType, IDType>, typename Iterator::value_type>
+        void addEdges(Iterator begin, Sentinel end) {
+            while (begin != end) {
+                addEdge(std::get<0>(*begin), std::get<1>(*begin));
+                ++begin;
+            }
+        }
+
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::same_as<std::pair<IDType, IDType>, typename Iterator::value_type>
+        void loadEdges(Iterator begin, Sentinel end, const EdgeLoadOptions& options = {}) {
+            graph_.loadEdges(begin, end, options);
+            for (Iterator it = begin; it != end; ++it) {
+                components_.unite(std::get<0>(*it), std::get<1>(*it));
+            }
+        }
+
+        const Graph& graph() const { return graph_; }
+
+        // Vertex access is for traversals, which need mutable flags. Edges added directly
+        // through a vertex bypass the union-find and are not reflected by connected().
+        VertexType& operator[](size_t pos) { return graph_[pos]; }
+        VertexIterator vertexBegin() { return graph_.vertexBegin(); }
+        VertexIterator vertexEnd() { return graph_.vertexEnd(); }
+        size_t vertexCount() { return graph_.vertexCount(); }
+        void reset() { graph_.reset(); }
+
+        bool connected(IDType a, IDType b) { return components_.connected(a, b); }
+        IDType componentOf(IDType id) { return components_.find(id); }
+        size_t componentSize(IDType id) { return components_.setSize(id); }
+        size_t componentCount() const { return components_.setCount(); }
+
+    private:
+        Graph graph_;
+        DisjointSets<IDType> components_;
+    };
+
+    template <VertexID Vertex, IsEdge Edge, bool Directed, typename Allocator = std::allocator<Vertex>>
+    requires std::same_as<typename Vertex::EdgeType, Edge> &&
+             std::same_as<typename Vertex::FlagType::IDType, typename Edge::IDType> &&
+             std::convertible_to<typename Vertex::FlagType::IDType, size_t>
+    class RandomAccessEdgeGraph {
+    public:
+        using AllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<Vertex>;
+        using EdgeAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<Edge>;
+        using VertexIterator = typename std::deque<Vertex, AllocatorType>::iterator;
+        using EdgeIterator = typename std::deque<Edge, EdgeAllocatorType>::iterator;
+        using VertexType = Vertex;
+        using EdgeType = Edge;
+        using IDType = typename Vertex::FlagType::IDType;
+        using EdgeValueType = typename Edge::ValueType;
+        static constexpr bool DIRECTED = Directed;
+
+        RandomAccessEdgeGraph() : vertices_{} {}
+        explicit RandomAccessEdgeGraph(const Allocator& allocator) : vertices_(allocator), edges_(allocator) {}
+        RandomAccessEdgeGraph(const RandomAccessEdgeGraph& g) :
+            vertices_(std::allocator_traits<AllocatorType>::select_on_container_copy_construction(
+                g.vertices_.get_allocator())),
+            edges_(std::allocator_traits<EdgeAllocatorType>::select_on_container_copy_construction(
+                g.edges_.get_allocator())) {
+            addVertices(g.vertexBegin(), g.vertexEnd());
+            copyEdges(g);
+        }
+
+        RandomAccessEdgeGraph(RandomAccessEdgeGraph&& g) noexcept = default;
+
+        RandomAccessEdgeGraph& operator=(const RandomAccessEdgeGraph& g) {
+            if (this == &g)
+                return *this;
+
+            vertices_.clear();
+            addVertices(g.vertexBegin(), g.vertexEnd());
+            copyEdges(g);
+
+            return *this;
+        }
+
+        RandomAccessEdgeGraph& operator=(RandomAccessEdgeGraph&& g)  noexcept = default;
+
+        Vertex& operator[] (size_t pos) { return vertices_[pos]; }
+        const Vertex& operator[] (size_t pos) const { return vertices_[pos]; }
+
+        void addVertex(const Vertex& vertex) { emplaceVertex(vertex); }
+
+        template <typename... Args>
+        requires std::constructible_from<Vertex, Args...>
+        void addVertex(Args&&... args) {
+            emplaceVertex(args...);
+            vertices_.back().flags.id = vertices_.size() - 1;
+        }
+
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::constructible_from<Vertex, typename Iterator::reference>
+        void addVertices(Iterator begin, Sentinel end) {
+            while (begin != end) {
+                addVertex(*begin);
+                ++begin;
+            }
+        }
+
+        template <typename... Args>
+        requires std::constructible_from<Edge, Args...>
+        void addEdge(Args&&... args) {
+            edges_.emplace_back(args...);
+            Edge& newest = edges_.back();
+
+            vertices_[newest.from()].addEdge(vertices_[newest.to()], newest);
+            if constexpr (!DIRECTED) {
+                vertices_[newest.to()].addEdge(vertices_[newest.from()], newest);
+            }
+        }
+
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::constructible_from<Edge, typename Iterator::reference>
+        void addEdges(Iterator begin, Sentinel end) {
+            while (begin != end) {
+                addEdge(*begin);
+                ++begin;
+            }
+        }
+
+        // Bulk version of addEdges: counts degrees first so every adjacency vector is
+        // allocated exactly once. A duplicate is an edge whose endpoints repeat an earlier
+        // input edge; the first one, with its value, is kept.
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::constructible_from<Edge, typename Iterator::reference>
+        void loadEdges(Iterator begin, Sentinel end, const EdgeLoadOptions& options = {}) {
+            std::vector<bool> keep = {};
+            if (options.removeDuplicates) {
+                keep = uniqueEdgeMask<Edge, DIRECTED>(begin, end, vertices_.size());
+            }
+
+            std::vector<size_t> degrees(vertices_.size(), 0);
+            size_t index = 0;
+            for (Iterator it = begin; it != end; ++it, ++index) {
+                Edge edge(*it);
+                if ((options.removeSelfLoops && edge.from() == edge.to()) || (!keep.empty() && !keep[index])) {
+                    continue;
+                }
+                ++degrees[edge.from()];
+                if constexpr (!DIRECTED) {
+                    ++degrees[edge.to()];
+                }
+            }
+
+            for (size_t i = 0; i < vertices_.size(); ++i) {
+                vertices_[i].reserve(vertices_[i].degree() + degrees[i]);
+            }
+
+            index = 0;
+            for (Iterator it = begin; it != end; ++it, ++index) {
+                Edge edge(*it);
+                if ((options.removeSelfLoops && edge.from() == edge.to()) || (!keep.empty() && !keep[index])) {
+                    continue;
+                }
+                addEdge(edge);
+            }
+
+            if (options.sortNeighbors) {
+                for (Vertex& vertex: vertices_) {
+                    vertex.sortEdges();
+                }
+            }
+        }
+
+        template <GraphEdge Graph>
+        void copyEdges(const Graph& g) {
+            addEdges(g.edgeBegin(), g.edgeEnd());
+        }
+
+        void reset() {
+            if (epoch_.advance()) {
+                return;
+            }
+            for (Vertex& vertex: vertices_) {
+                vertex.reset();
+            }
+        }
+
+        size_t vertexCount() {
+            return vertices_.size();
+        }
+
+        size_t edgeCount() {
+            return edges_.size();
+        }
+
+        VertexIterator vertexBegin() { return vertices_.begin(); }
+        VertexIterator vertexEnd() { return vertices_.end(); }
+
+        EdgeIterator edgeBegin() { return  edges_.begin(); }
+        EdgeIterator edgeEnd() { return edges_.end(); }
+
+    private:
+        std::deque<Vertex, AllocatorType> vertices_;
+        std::deque<Edge, EdgeAllocatorType> edges_;
+        GraphEpoch<typename Vertex::FlagType> epoch_;
+
+        template <typename... Args>
+        void emplaceVertex(Args&&... args) {
+            if constexpr (std::uses_allocator_v<Vertex, AllocatorType>) {
+                vertices_.emplace_back(std::allocator_arg, vertices_.get_allocator(), args...);
+            } else {
+                vertices_.emplace_back(args...);
+            }
+            epoch_.bind(vertices_.back().flags);
+        }
+    };
+
+    template <typename Data, typename Allocator = std::allocator<void>>
+    class APFlag {
+    private:
+        bool visited_ = false;
+    public:
+        using DType = size_t;
+        using LType = DType;
+        using IDType = DType;
+        DType dist;
+        LType low;
+        IDType id;
+        VectorVertex<Data, APFlag<Data, Allocator>, Allocator>* prev;
+
+        APFlag() : visited_{false}, dist{0}, low{0}, prev{nullptr} {}
+
+        void visit() { visited_ = true; }
+        bool visited() const { return visited_; }
+        void reset() {
+            visited_ = false;
+            dist = 0;
+            low = 0;
+            prev = nullptr;
+        }
+
+        static DType zeroDist() {
+            return 0;
+        }
+
+        static DType maxDist() {
+            return std::numeric_limits<DType>::max();
+        }
+    };
+
+    template <typename Data, typename Edge, typename Allocator = std::allocator<void>>
+    class APEFlag {
+    private:
+        bool visited_ = false;
+    public:
+        using DType = size_t;
+        using LType = DType;
+        using IDType = DType;
+        DType dist;
+        LType low;
+        IDType id;
+        VectorEdgeVertex<Data, APEFlag<Data, Edge, Allocator>, Edge, Allocator>* prev;
+
+        APEFlag() : visited_{false}, dist{0}, low{0}, prev{nullptr} {}
+
+        void visit() { visited_ = true; }
+        bool visited() const { return visited_; }
+        void reset() {
+            visited_ = false;
+            dist = 0;
+            low = 0;
+            prev = nullptr;
+        }
+
+        static DType zeroDist() {
+            return 0;
+        }
+
+        static DType maxDist() {
+            return std::numeric_limits<DType>::max();
+        }
+    };
+
+    template <typename Data, typename Flag, typename Edge>
+    class CompressedVertex {
+    public:
+        Flag flags;
+        Data data;
+        using ThisType = CompressedVertex<Data, Flag, Edge>;
+        using PairType = std::pair<ThisType*, Edge*>;
+        using FlagType = Flag;
+        using EdgeType = Edge;
+        using PairIterator = PairType*;
+
+        class iterator {
+        protected:
+            iterator () : it_{nullptr} {}
+            explicit iterator(PairIterator it) : it_(it) {}
+
+        public:
+            friend bool operator== (const iterator& a, const iterator& b) { return a.it_ == b.it_; };
+            friend bool operator!= (const iterator& a, const iterator& b) { return a.it_ != b.it_; };
+        protected:
+            PairIterator it_;
+        };
+
+        class VertexIterator : public ThisType::iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = ThisType;
+            using pointer           = value_type*;
+            using reference         = value_type&;
+
+            VertexIterator() : iterator() {}
+            explicit VertexIterator(PairIterator it) : iterator(it) {}
+
+            reference operator*() const { return *std::get<0>(*this->it_); }
+            pointer operator->() { return std::get<0>(*this->it_); }
+
+            VertexIterator& operator++() { this->it_++; return *this; }
+            VertexIterator operator++(int) { VertexIterator tmp = *this; ++(*this); return tmp; }
+        };
+
+        class EdgeIterator : public ThisType::iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = Edge;
+            using pointer           = value_type*;
+            using reference         = value_type&;
+
+            EdgeIterator() : iterator() {}
+            explicit EdgeIterator(PairIterator it) : iterator(it) {}
+
+            reference operator*() const { return *std::get<1>(*this->it_); }
+            pointer operator->() { return std::get<1>(*this->it_); }
+
+            EdgeIterator& operator++() { this->it_++; return *this; }
+            EdgeIterator operator++(int) { EdgeIterator tmp = *this; ++(*this); return tmp; }
+        };
+
+        CompressedVertex() : flags{}, data{}, first_{nullptr}, last_{nullptr} {}
+        explicit CompressedVertex(const Data& d) : flags{}, data(d), first_{nullptr}, last_{nullptr} {}
+        CompressedVertex(const CompressedVertex& v) : flags(v.flags), data(v.data), first_{nullptr}, last_{nullptr} {}
+        CompressedVertex(CompressedVertex&& v)  noexcept = default;
+
+        template <typename... Args>
+        requires std::constructible_from<Data, Args...>
+        explicit CompressedVertex(Args&&... args) : flags{}, data{args...}, first_{nullptr}, last_{nullptr} {}
+
+        CompressedVertex& operator=(const CompressedVertex& v) {
+            if (this == &v)
+                return *this;
+
+            flags = v.flags;
+            data = v.data;
+            first_ = nullptr;
+            last_ = nullptr;
+
+            return *this;
+        }
+
+        CompressedVertex& operator=(CompressedVertex&& v)  noexcept = default;
+
+        // Called by the owning graph whenever its adjacency array is (re)built.
+        void assignPairs(PairIterator first, PairIterator last) {
+            first_ = first;
+            last_ = last;
+        }
+
+        void reset() {
+            flags.reset();
+        }
+
+        size_t degree() const { return last_ - first_; }
+
+        VertexIterator vertexBegin() { return VertexIterator(first_); }
+        VertexIterator vertexEnd() { return VertexIterator(last_); }
+
+        EdgeIterator edgeBegin() { return EdgeIterator(first_); }
+        EdgeIterator edgeEnd() { return EdgeIterator(last_); }
+
+        PairIterator pairBegin() { return first_; }
+        PairIterator pairEnd() { return last_; }
+
+    private:
+        PairIterator first_;
+        PairIterator last_;
+    };
+
+    // Compressed sparse row graph whose edges are fixed once built; only
+    // isolated vertices can be appended. Neighbours of vertex i occupy
+    // adjacency_[offsets_[i], offsets_[i + 1]), so a traversal reads one
+    // contiguous block per vertex. Directed graphs keep edges_ in the same
+    // order as adjacency_; undirected graphs keep every edge once, in input
+    // order, and reference it from both endpoints.
+    template <VertexID Vertex, IsEdge Edge, bool Directed>
+    requires std::same_as<typename Vertex::EdgeType, Edge> &&
+             std::same_as<typename Vertex::PairType, std::pair<Vertex*, Edge*>> &&
+             std::same_as<typename Vertex::FlagType::IDType, typename Edge::IDType> &&
+             std::convertible_to<typename Vertex::FlagType::IDType, size_t>
+    class CompressedSparseGraph {
+    public:
+        using VertexIterator = typename std::vector<Vertex>::iterator;
+        using EdgeIterator = typename std::vector<Edge>::iterator;
+        using VertexType = Vertex;
+        using EdgeType = Edge;
+        using PairType = typename Vertex::PairType;
+        using IDType = typename Vertex::FlagType::IDType;
+        using EdgeValueType = typename Edge::ValueType;
+        static constexpr bool DIRECTED = Directed;
+
+        CompressedSparseGraph() : vertices_{}, edges_{}, offsets_{0}, adjacency_{} {}
+
+        template <GraphID Graph>
+        requires GraphEdge<Graph> || std::default_initializable<EdgeValueType>
+        explicit CompressedSparseGraph(Graph& graph) : CompressedSparseGraph() {
+            vertices_.reserve(graph.vertexCount());
+            for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
+                addVertex(it->data);
+            }
+
+            if constexpr (GraphEdge<Graph>) {
+                edges_.reserve(graph.edgeCount());
+                for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+                    edges_.emplace_back(it->from(), it->to(), it->value);
+                }
+            } else {
+                for (auto from = graph.vertexBegin(); from != graph.vertexEnd(); ++from) {
+                    bool skipLoop = false;
+                    for (auto to = from->vertexBegin(); to != from->vertexEnd(); ++to) {
+                        if constexpr (!DIRECTED) {
+                            if (from->flags.id > to->flags.id) {
+                                continue;
+                            }
+                            // An undirected self-loop is stored twice in the source adjacency.
+                            if (from->flags.id == to->flags.id) {
+                                skipLoop = !skipLoop;
+                                if (skipLoop) {
+                                    continue;
+                                }
+                            }
+                        }
+                        edges_.emplace_back(from->flags.id, to->flags.id, EdgeValueType{});
+                    }
+                }
+            }
+
+            build();
+        }
+
+        template <std::forward_iterator VIterator, std::sentinel_for<VIterator> VSentinel,
+                  std::forward_iterator EIterator, std::sentinel_for<EIterator> ESentinel>
+        requires std::constructible_from<Vertex, typename VIterator::reference> &&
+                 std::constructible_from<Edge, typename EIterator::reference>
+        CompressedSparseGraph(VIterator vertexBegin, VSentinel vertexEnd, EIterator edgeBegin, ESentinel edgeEnd) :
+            CompressedSparseGraph() {
+            addVertices(vertexBegin, vertexEnd);
+            for (EIterator it = edgeBegin; it != edgeEnd; ++it) {
+                edges_.emplace_back(*it);
+            }
+
+            build();
+        }
+
+        CompressedSparseGraph(const CompressedSparseGraph& g) :
+            vertices_{g.vertices_}, edges_{g.edges_}, offsets_{0}, adjacency_{} {
+            build();
+        }
+
+        CompressedSparseGraph(CompressedSparseGraph&& g) noexcept = default;
+
+        CompressedSparseGraph& operator=(const CompressedSparseGraph& g) {
+            if (this == &g)
+                return *this;
+
+            vertices_ = g.vertices_;
+            edges_ = g.edges_;
+            build();
+
+            return *this;
+        }
+
+        CompressedSparseGraph& operator=(CompressedSparseGraph&& g)  noexcept = default;
+
+        Vertex& operator[] (size_t pos) { return vertices_[pos]; }
+        const Vertex& operator[] (size_t pos) const { return vertices_[pos]; }
+
+        // Appending a vertex never touches the adjacency array: the new vertex is isolated,
+        // and a copied vertex takes its position as id rather than the one it was copied with.
+        void addVertex(const Vertex& vertex) {
+            relocateVertices([this, &vertex]() { vertices_.emplace_back(vertex); });
+            vertices_.back().flags.id = vertices_.size() - 1;
+        }
+
+        template <typename... Args>
+        requires std::constructible_from<Vertex, Args...>
+        void addVertex(Args&&... args) {
+            relocateVertices([this, &args...]() { vertices_.emplace_back(args...); });
+            vertices_.back().flags.id = vertices_.size() - 1;
+        }
+
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::constructible_from<Vertex, typename Iterator::reference>
+        void addVertices(Iterator begin, Sentinel end) {
+            while (begin != end) {
+                addVertex(*begin);
+                ++begin;
+            }
+        }
+
+        void reset() {
+            if (epoch_.advance()) {
+                return;
+            }
+            for (Vertex& vertex: vertices_) {
+                vertex.reset();
+            }
+        }
+
+        size_t vertexCount() {
+            return vertices_.size();
+        }
+
+        size_t edgeCount() {
+            return edges_.size();
+        }
+
+        size_t degree(IDType id) const {
+            return offsets_[id + 1] - offsets_[id];
+        }
+
+        VertexIterator vertexBegin() { return vertices_.begin(); }
+        VertexIterator vertexEnd() { return vertices_.end(); }
+
+        EdgeIterator edgeBegin() { return edges_.begin(); }
+        EdgeIterator edgeEnd() { return edges_.end(); }
+
+    private:
+        std::vector<Vertex> vertices_;
+        std::vector<Edge> edges_;
+        std::vector<size_t> offsets_;
+        std::vector<PairType> adjacency_;
+        GraphEpoch<typename Vertex::FlagType> epoch_;
+
+        template <typename Callable>
+        void relocateVertices(const Callable& append) {
+            if (vertices_.size() < vertices_.capacity()) {
+                append();
+                epoch_.bind(vertices_.back().flags);
+                offsets_.push_back(offsets_.back());
+                vertices_.back().assignPairs(adjacency_.data() + offsets_.back(),
+                                             adjacency_.data() + offsets_.back());
+                return;
+            }
+
+            std::vector<size_t> targets(adjacency_.size());
+            for (size_t i = 0; i < adjacency_.size(); ++i) {
+                targets[i] = std::get<0>(adjacency_[i]) - vertices_.data();
+            }
+
+            append();
+            epoch_.bind(vertices_.back().flags);
+            offsets_.push_back(offsets_.back());
+
+            for (size_t i = 0; i < adjacency_.size(); ++i) {
+                std::get<0>(adjacency_[i]) = &vertices_[targets[i]];
+            }
+            assignPairs();
+        }
+
+        void assignPairs() {
+            for (size_t i = 0; i < vertices_.size(); ++i) {
+                vertices_[i].assignPairs(adjacency_.data() + offsets_[i], adjacency_.data() + offsets_[i + 1]);
+            }
+        }
+
+        // Also binds the vertices to this graph's epoch, as copies arrive bound to the source's.
+        void build() {
+            for (Vertex& vertex: vertices_) {
+                epoch_.bind(vertex.flags);
+            }
+            offsets_.assign(vertices_.size() + 1, 0);
+            for (Edge& edge: edges_) {
+                ++offsets_[static_cast<size_t>(edge.from()) + 1];
+                if constexpr (!DIRECTED) {
+                    ++offsets_[static_cast<size_t>(edge.to()) + 1];
+                }
+            }
+            for (size_t i = 1; i < offsets_.size(); ++i) {
+                offsets_[i] += offsets_[i - 1];
+            }
+
+            if constexpr (DIRECTED) {
+                sortEdges();
+            }
+
+            std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+            adjacency_.assign(offsets_.back(), PairType(nullptr, nullptr));
+            for (Edge& edge: edges_) {
+                adjacency_[next[edge.from()]++] = PairType(&vertices_[edge.to()], &edge);
+                if constexpr (!DIRECTED) {
+                    adjacency_[next[edge.to()]++] = PairType(&vertices_[edge.from()], &edge);
+                }
+            }
+
+            assignPairs();
+        }
+
+        // Stable counting sort of edges_ by source, so that adjacency_ and edges_ share one order.
+        void sortEdges() {
+            std::vector<size_t> order(edges_.size());
+            std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+            bool sorted = true;
+            for (size_t i = 0; i < edges_.size(); ++i) {
+                size_t position = next[edges_[i].from()]++;
+                order[position] = i;
+                sorted = sorted && position == i;
+            }
+
+            if (sorted) {
+                return;
+            }
+
+            std::vector<Edge> edges = {};
+            edges.reserve(edges_.size());
+            for (size_t i: order) {
+                edges.push_back(std::move(edges_[i]));
+            }
+            edges_ = std::move(edges);
+        }
+    };
+
+    template <typename Data, typename Edge>
+    class APCFlag {
+    private:
+        bool visited_ = false;
+    public:
+        using DType = size_t;
+        using LType = DType;
+        using IDType = typename Edge::IDType;
+        DType dist;
+        LType low;
+        IDType id;
+        CompressedVertex<Data, APCFlag<Data, Edge>, Edge>* prev;
+
+        APCFlag() : visited_{false}, dist{0}, low{0}, id{0}, prev{nullptr} {}
 
-            return *this;
+        void visit() { visited_ = true; }
+        bool visited() const { return visited_; }
+        void reset() {
+            visited_ = false;
+            dist = 0;
+            low = 0;
+            prev = nullptr;
         }
 
-        VectorVertex& operator=(VectorVertex&& v)  noexcept = default;
-
-        void addEdge(ThisType& to) {
-            vertices_.push_back(&to);
+        static DType zeroDist() {
+            return 0;
         }
 
-        void reset() {
-            flags.reset();
+        static DType maxDist() {
+            return std::numeric_limits<DType>::max();
         }
-
-        iterator vertexBegin() { return iterator(vertices_.begin()); }
-        iterator vertexEnd() { return iterator(vertices_.end()); }
     };
+    // Adjacency is split in two parallel arrays. The hot one holds 32-bit neighbour IDs with
+    // the edge value copied inline, which is all a shortest-path relaxation reads (see
+    // arcBegin()). The cold one holds the index of the shared edge record in the owning
+    // IndexedEdgeGraph and is only read by the edge and pair iterators, which hand out Edge
+    // pointers that may be written through. Values changed that way are not copied back into
+    // the arcs. IDs are resolved through a storage slot published by the graph; a vertex
+    // outside a graph has no edges.
+    template <typename Data, typename Flag, typename Edge, typename Allocator = std::allocator<void>>
+    class IndexedEdgeVertex {
+    public:
+        struct ArcType {
+            std::uint32_t target;
+            typename Edge::ValueType value;
+        };
 
-    template <typename Data, typename Flag, typename Edge>
-    class VectorEdgeVertex {
+        struct StorageType {
+            IndexedEdgeVertex* vertices = nullptr;
+            Edge* edges = nullptr;
+        };
     private:
-        std::vector<std::pair<VectorEdgeVertex<Data, Flag, Edge>*, Edge*>> vertices_;
+        std::vector<ArcType, typename std::allocator_traits<Allocator>::template rebind_alloc<ArcType>> arcs_;
+        std::vector<std::uint32_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t>> edgeIDs_;
+        const StorageType* storage_ = nullptr;
     public:
         Flag flags;
         Data data;
-        using ThisType = VectorEdgeVertex<Data, Flag, Edge>;
+        using ThisType = IndexedEdgeVertex<Data, Flag, Edge, Allocator>;
         using PairType = std::pair<ThisType*, Edge*>;
-        using ContainerType = std::vector<PairType>;
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<ArcType>;
+        using ContainerType = std::vector<ArcType, allocator_type>;
+        using IDAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t>;
+        using IDContainerType = std::vector<std::uint32_t, IDAllocatorType>;
+        using ArcIterator = ArcType*;
         using FlagType = Flag;
         using EdgeType = Edge;
-        using PairIterator = typename ContainerType::iterator;
-
-        class iterator {
-        protected:
-            iterator () : it_{} {}
-            explicit iterator(typename ContainerType::iterator it) : it_(it) {}
 
-        public:
-            friend bool operator== (const iterator& a, const iterator& b) { return a.it_ == b.it_; };
-            friend bool operator!= (const iterator& a, const iterator& b) { return a.it_ != b.it_; };
-        protected:
-            typename ContainerType::iterator it_;
-        };
-
-        class VertexIterator : public ThisType::iterator {
+        class VertexIterator {
         public:
             using iterator_category = std::forward_iterator_tag;
             using difference_type   = std::ptrdiff_t;
@@ -212,17 +2354,23 @@ namespace sgl {
             using pointer           = value_type*;
             using reference         = value_type&;
 
-            VertexIterator() : iterator() {}
-            explicit VertexIterator(typename ContainerType::iterator it) : iterator(it) {}
+            VertexIterator() : base_{nullptr}, it_{nullptr} {}
+            VertexIterator(ThisType* base, const ArcType* it) : base_{base}, it_(it) {}
 
-            reference operator*() const { return *std::get<0>(*this->it_); }
-            pointer operator->() { return std::get<0>(*this->it_); }
+            reference operator*() const { return base_[it_->target]; }
+            pointer operator->() { return base_ + it_->target; }
 
-            VertexIterator& operator++() { this->it_++; return *this; }
+            VertexIterator& operator++() { it_++; return *this; }
             VertexIterator operator++(int) { VertexIterator tmp = *this; ++(*this); return tmp; }
+
+            friend bool operator== (const VertexIterator& a, const VertexIterator& b) { return a.it_ == b.it_; };
+            friend bool operator!= (const VertexIterator& a, const VertexIterator& b) { return a.it_ != b.it_; };
+        private:
+            ThisType* base_;
+            const ArcType* it_;
         };
 
-        class EdgeIterator : public ThisType::iterator {
+        class EdgeIterator {
         public:
             using iterator_category = std::forward_iterator_tag;
             using difference_type   = std::ptrdiff_t;
@@ -230,194 +2378,184 @@ namespace sgl {
             using pointer           = value_type*;
             using reference         = value_type&;
 
-            EdgeIterator() : iterator() {}
-            explicit EdgeIterator(typename ContainerType::iterator it) : iterator(it) {}
+            EdgeIterator() : edges_{nullptr}, it_{nullptr} {}
+            EdgeIterator(Edge* edges, const std::uint32_t* it) : edges_{edges}, it_(it) {}
 
-            reference operator*() const { return *std::get<1>(*this->it_); }
-            pointer operator->() { return std::get<1>(*this->it_); }
+            reference operator*() const { return edges_[*it_]; }
+            pointer operator->() { return edges_ + *it_; }
 
-            EdgeIterator& operator++() { this->it_++; return *this; }
+            EdgeIterator& operator++() { it_++; return *this; }
             EdgeIterator operator++(int) { EdgeIterator tmp = *this; ++(*this); return tmp; }
+
+            friend bool operator== (const EdgeIterator& a, const EdgeIterator& b) { return a.it_ == b.it_; };
+            friend bool operator!= (const EdgeIterator& a, const EdgeIterator& b) { return a.it_ != b.it_; };
+        private:
+            Edge* edges_;
+            const std::uint32_t* it_;
         };
 
-        VectorEdgeVertex() : vertices_{}, flags{}, data{} {}
-        explicit VectorEdgeVertex(const Data& d) : vertices_{}, flags{}, data(d) {}
-        VectorEdgeVertex(const VectorEdgeVertex& v) : vertices_{}, flags(v.flags), data(v.data) {}
-        VectorEdgeVertex(VectorEdgeVertex&& v)  noexcept = default;
+        // Pairs are assembled on the fly, so dereferencing yields a value rather than a reference.
+        class PairIterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = PairType;
+            using reference         = PairType;
+
+            PairIterator() : base_{nullptr}, edges_{nullptr}, arc_{nullptr}, edge_{nullptr} {}
+            PairIterator(ThisType* base, Edge* edges, const ArcType* arc, const std::uint32_t* edge) :
+                base_{base}, edges_{edges}, arc_{arc}, edge_{edge} {}
+
+            reference operator*() const { return PairType(base_ + arc_->target, edges_ + *edge_); }
+
+            PairIterator& operator++() { arc_++; edge_++; return *this; }
+            PairIterator operator++(int) { PairIterator tmp = *this; ++(*this); return tmp; }
+
+            friend bool operator== (const PairIterator& a, const PairIterator& b) { return a.arc_ == b.arc_; };
+            friend bool operator!= (const PairIterator& a, const PairIterator& b) { return a.arc_ != b.arc_; };
+        private:
+            ThisType* base_;
+            Edge* edges_;
+            const ArcType* arc_;
+            const std::uint32_t* edge_;
+        };
+
+        IndexedEdgeVertex() : arcs_{}, edgeIDs_{}, flags{}, data{} {}
+        explicit IndexedEdgeVertex(const Data& d) : arcs_{}, edgeIDs_{}, flags{}, data(d) {}
+        IndexedEdgeVertex(const IndexedEdgeVertex& v) :
+            arcs_(std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                v.arcs_.get_allocator())),
+            edgeIDs_(std::allocator_traits<IDAllocatorType>::select_on_container_copy_construction(
+                v.edgeIDs_.get_allocator())), storage_{nullptr}, flags(v.flags), data(v.data) {}
+        IndexedEdgeVertex(IndexedEdgeVertex&& v)  noexcept = default;
 
         template <typename... Args>
         requires std::constructible_from<Data, Args...>
-        explicit VectorEdgeVertex(Args&&... args) : vertices_{}, flags{}, data{args...} {}
+        explicit IndexedEdgeVertex(Args&&... args) : arcs_{}, edgeIDs_{}, flags{}, data{args...} {}
 
-        VectorEdgeVertex& operator=(const VectorEdgeVertex& v) {
+        IndexedEdgeVertex(std::allocator_arg_t, const allocator_type& alloc) :
+            arcs_(alloc), edgeIDs_(IDAllocatorType(alloc)), flags{}, data{} {}
+        IndexedEdgeVertex(std::allocator_arg_t, const allocator_type& alloc, const IndexedEdgeVertex& v) :
+            arcs_(alloc), edgeIDs_(IDAllocatorType(alloc)), flags(v.flags), data(v.data) {}
+
+        template <typename... Args>
+        requires std::constructible_from<Data, Args...>
+        IndexedEdgeVertex(std::allocator_arg_t, const allocator_type& alloc, Args&&... args) :
+            arcs_(alloc), edgeIDs_(IDAllocatorType(alloc)), flags{}, data{args...} {}
+
+        IndexedEdgeVertex& operator=(const IndexedEdgeVertex& v) {
             if (this == &v)
                 return *this;
 
-            vertices_ = {};
+            arcs_ = ContainerType(arcs_.get_allocator());
+            edgeIDs_ = IDContainerType(edgeIDs_.get_allocator());
             flags = v.flags;
             data = v.data;
 
             return *this;
         }
 
-        VectorEdgeVertex& operator=(VectorEdgeVertex&& v)  noexcept = default;
+        IndexedEdgeVertex& operator=(IndexedEdgeVertex&& v)  noexcept = default;
 
-        void addEdge(ThisType& vertex, Edge& edge) {
-            vertices_.push_back(std::pair(&vertex, &edge));
+        // Called by the owning graph; edge is the position of the record in its edge array.
+        void addEdge(std::uint32_t neighbour, std::uint32_t edge, const typename Edge::ValueType& value) {
+            arcs_.push_back(ArcType{neighbour, value});
+            edgeIDs_.push_back(edge);
         }
 
-        void reset() {
-            flags.reset();
+        void reserve(size_t capacity) {
+            arcs_.reserve(capacity);
+            edgeIDs_.reserve(capacity);
         }
 
-        VertexIterator vertexBegin() { return VertexIterator(vertices_.begin()); }
-        VertexIterator vertexEnd() { return VertexIterator(vertices_.end()); }
-
-        EdgeIterator edgeBegin() { return EdgeIterator(vertices_.begin()); }
-        EdgeIterator edgeEnd() { return EdgeIterator(vertices_.end()); }
-
-        PairIterator pairBegin() { return vertices_.begin(); }
-        PairIterator pairEnd() { return vertices_.end(); }
-    };
-
-	template <VertexID Vertex, bool Directed>
-	requires std::convertible_to<typename Vertex::FlagType::IDType, size_t>
-	class RandomAccessGraph {
-		public:
-		using VertexIterator = typename std::deque<Vertex>::iterator;
-        using VertexType = Vertex;
-        using IDType = typename Vertex::FlagType::IDType;
-        static constexpr bool DIRECTED = Directed;
-		
-		RandomAccessGraph() : vertices_{} {}
-        RandomAccessGraph(const RandomAccessGraph& g) : vertices_{} {
-            addVertices(g.vertexBegin(), g.vertexEnd());
-            copyEdges(g);
+        size_t degree() const { return arcs_.size(); }
+
+        void sortEdges() {
+            std::vector<size_t> order(arcs_.size());
+            std::iota(order.begin(), order.end(), size_t{0});
+            std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+                return arcs_[a].target < arcs_[b].target;
+            });
+
+            ContainerType arcs(arcs_.get_allocator());
+            IDContainerType edgeIDs(edgeIDs_.get_allocator());
+            arcs.reserve(arcs_.size());
+            edgeIDs.reserve(edgeIDs_.size());
+            for (size_t i: order) {
+                arcs.push_back(arcs_[i]);
+                edgeIDs.push_back(edgeIDs_[i]);
+            }
+            arcs_ = std::move(arcs);
+            edgeIDs_ = std::move(edgeIDs);
         }
 
-        RandomAccessGraph(RandomAccessGraph&& g) noexcept = default;
-
-        RandomAccessGraph& operator=(const RandomAccessGraph& g) {
-            if (this == &g)
-                return *this;
-
-            vertices_ = {};
-            addVertices(g.vertexBegin(), g.vertexEnd());
-            copyEdges(g);
-
-            return *this;
+        void reset() {
+            flags.reset();
         }
 
-        RandomAccessGraph& operator=(RandomAccessGraph&& g)  noexcept = default;
-
-        Vertex& operator[] (size_t pos) { return vertices_[pos]; }
-        const Vertex& operator[] (size_t pos) const { return vertices_[pos]; }
-
-		void addVertex(const Vertex& vertex) { vertices_.emplace_back(vertex); }
-
-        template <typename... Args>
-        requires std::constructible_from<Vertex, Args...>
-        void addVertex(Args&&... args) {
-            vertices_.emplace_back(args...);
-            vertices_.back().flags.id = vertices_.size() - 1;
-        }
-		
-		template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
-        requires std::constructible_from<Vertex, typename Iterator::reference>
-		void addVertices(Iterator begin, Sentinel end) {
-			while (begin != end) {
-				addVertex(*begin);
-				++begin;
-			}
-		}
+        // Called by the owning graph with the slot that holds its vertex and edge arrays.
+        void bindStorage(const StorageType* storage) { storage_ = storage; }
 
-        void addEdge(IDType from, IDType to) {
-            vertices_[from].addEdge(vertices_[to]);
-            if constexpr (!DIRECTED) {
-                vertices_[to].addEdge(vertices_[from]);
-            }
-        }
+        // Raw adjacency for relaxation loops: arc->target indexes the graph, arc->value is a
+        // copy of the edge value taken when the edge was added.
+        ArcIterator arcBegin() { return arcs_.data(); }
+        ArcIterator arcEnd() { return arcs_.data() + arcs_.size(); }
 
-        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
-        requires std::same_as<std::pair<IDType, IDType>, typename Iterator::value_type>
-        void addEdges(Iterator begin, Sentinel end) {
-            while (begin != end) {
-                addEdge(std::get<0>(*begin), std::get<1>(*begin));
-                ++begin;
-            }
-        }
+        VertexIterator vertexBegin() { return VertexIterator(vertices(), arcs_.data()); }
+        VertexIterator vertexEnd() { return VertexIterator(vertices(), arcs_.data() + arcs_.size()); }
 
-        template <GraphID Graph>
-        void copyEdges(const Graph& g) {
-            for (auto from = g.vertexBegin(); from != g.vertexEnd(); ++from) {
-                for (auto to = from->vertexBegin(); to != from->vertexEnd(); ++to) {
-                    vertices_[from->flags.id].addEdge(vertices_[to->flags.id]);
-                }
-            }
-        }
-		
-		void reset() {
-			for (Vertex& vertex: vertices_) {
-				vertex.reset();
-			}
-		}
+        EdgeIterator edgeBegin() { return EdgeIterator(edges(), edgeIDs_.data()); }
+        EdgeIterator edgeEnd() { return EdgeIterator(edges(), edgeIDs_.data() + edgeIDs_.size()); }
 
-        size_t vertexCount() {
-            return vertices_.size();
+        PairIterator pairBegin() { return PairIterator(vertices(), edges(), arcs_.data(), edgeIDs_.data()); }
+        PairIterator pairEnd() {
+            return PairIterator(vertices(), edges(), arcs_.data() + arcs_.size(), edgeIDs_.data() + edgeIDs_.size());
         }
 
-		VertexIterator vertexBegin() { return vertices_.begin(); }
-		VertexIterator vertexEnd() { return vertices_.end(); }
-
-		private:
-		std::deque<Vertex> vertices_;
-	};
+    private:
+        ThisType* vertices() { return storage_ == nullptr ? nullptr : storage_->vertices; }
+        Edge* edges() { return storage_ == nullptr ? nullptr : storage_->edges; }
+    };
 
-    template <VertexID Vertex, IsEdge Edge, bool Directed>
+    // Vertices live in one array indexed by their IDs and edge records in another, each stored
+    // once; an undirected edge is listed in both endpoints' adjacency, as in
+    // RandomAccessEdgeGraph, with its value copied into both arcs. IDs and edge positions must
+    // fit in 32 bits. Edge pointers taken from the graph are invalidated by adding edges.
+    template <VertexID Vertex, IsEdge Edge, bool Directed, typename Allocator = std::allocator<Vertex>>
     requires std::same_as<typename Vertex::EdgeType, Edge> &&
              std::same_as<typename Vertex::FlagType::IDType, typename Edge::IDType> &&
              std::convertible_to<typename Vertex::FlagType::IDType, size_t>
-    class RandomAccessEdgeGraph {
+    class IndexedEdgeGraph {
     public:
-        using VertexIterator = typename std::deque<Vertex>::iterator;
-        using EdgeIterator = typename std::deque<Edge>::iterator;
+        using AllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<Vertex>;
+        using EdgeAllocatorType = typename std::allocator_traits<Allocator>::template rebind_alloc<Edge>;
+        using VertexIterator = typename std::vector<Vertex, AllocatorType>::iterator;
+        using EdgeIterator = typename std::vector<Edge, EdgeAllocatorType>::iterator;
         using VertexType = Vertex;
         using EdgeType = Edge;
         using IDType = typename Vertex::FlagType::IDType;
         using EdgeValueType = typename Edge::ValueType;
         static constexpr bool DIRECTED = Directed;
 
-        RandomAccessEdgeGraph() : vertices_{} {}
-        RandomAccessEdgeGraph(const RandomAccessEdgeGraph& g) : vertices_{} {
-            addVertices(g.vertexBegin(), g.vertexEnd());
-            copyEdges(g);
-        }
-
-        RandomAccessEdgeGraph(RandomAccessEdgeGraph&& g) noexcept = default;
-
-        RandomAccessEdgeGraph& operator=(const RandomAccessEdgeGraph& g) {
-            if (this == &g)
-                return *this;
-
-            vertices_ = {};
-            addVertices(g.vertexBegin(), g.vertexEnd());
-            copyEdges(g);
-
-            return *this;
-        }
+        IndexedEdgeGraph() : vertices_{}, edges_{}, storage_{std::make_unique<StorageType>()} {}
+        explicit IndexedEdgeGraph(const Allocator& allocator) :
+            vertices_(allocator), edges_(allocator), storage_{std::make_unique<StorageType>()} {}
 
-        RandomAccessEdgeGraph& operator=(RandomAccessEdgeGraph&& g)  noexcept = default;
+        IndexedEdgeGraph(const IndexedEdgeGraph& g) = delete;
+        IndexedEdgeGraph(IndexedEdgeGraph&& g) noexcept = default;
+        IndexedEdgeGraph& operator=(const IndexedEdgeGraph& g) = delete;
+        IndexedEdgeGraph& operator=(IndexedEdgeGraph&& g)  noexcept = default;
 
         Vertex& operator[] (size_t pos) { return vertices_[pos]; }
         const Vertex& operator[] (size_t pos) const { return vertices_[pos]; }
 
-        void addVertex(const Vertex& vertex) { vertices_.emplace_back(vertex); }
+        // Vertices are indexed by position, so a copied vertex gets the ID of its new slot.
+        void addVertex(const Vertex& vertex) { emplaceVertex(vertex); }
 
         template <typename... Args>
         requires std::constructible_from<Vertex, Args...>
         void addVertex(Args&&... args) {
-            vertices_.emplace_back(args...);
-            vertices_.back().flags.id = vertices_.size() - 1;
+            emplaceVertex(args...);
         }
 
         template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
@@ -433,11 +2571,15 @@ namespace sgl {
         requires std::constructible_from<Edge, Args...>
         void addEdge(Args&&... args) {
             edges_.emplace_back(args...);
+            storage_->edges = edges_.data();
             Edge& newest = edges_.back();
+            auto position = static_cast<std::uint32_t>(edges_.size() - 1);
 
-            vertices_[newest.from()].addEdge(vertices_[newest.to()], newest);
+            vertices_[newest.from()].addEdge(static_cast<std::uint32_t>(newest.to()), position, newest.value);
             if constexpr (!DIRECTED) {
-                vertices_[newest.to()].addEdge(vertices_[newest.from()], newest);
+                if (newest.from() != newest.to()) {
+                    vertices_[newest.to()].addEdge(static_cast<std::uint32_t>(newest.from()), position, newest.value);
+                }
             }
         }
 
@@ -450,12 +2592,57 @@ namespace sgl {
             }
         }
 
-        template <GraphEdge Graph>
-        void copyEdges(const Graph& g) {
-            addEdges(g.edgeBegin(), g.edgeEnd());
+        // Bulk version of addEdges: counts degrees first so every adjacency vector is
+        // allocated exactly once. A duplicate is an edge whose endpoints repeat an earlier
+        // input edge; the first one, with its value, is kept.
+        template <std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+        requires std::constructible_from<Edge, typename Iterator::reference>
+        void loadEdges(Iterator begin, Sentinel end, const EdgeLoadOptions& options = {}) {
+            std::vector<bool> keep = {};
+            if (options.removeDuplicates) {
+                keep = uniqueEdgeMask<Edge, DIRECTED>(begin, end, vertices_.size());
+            }
+
+            std::vector<size_t> degrees(vertices_.size(), 0);
+            size_t kept = 0;
+            size_t index = 0;
+            for (Iterator it = begin; it != end; ++it, ++index) {
+                Edge edge(*it);
+                if ((options.removeSelfLoops && edge.from() == edge.to()) || (!keep.empty() && !keep[index])) {
+                    continue;
+                }
+                ++kept;
+                ++degrees[edge.from()];
+                if constexpr (!DIRECTED) {
+                    ++degrees[edge.to()];
+                }
+            }
+
+            edges_.reserve(edges_.size() + kept);
+            for (size_t i = 0; i < vertices_.size(); ++i) {
+                vertices_[i].reserve(vertices_[i].degree() + degrees[i]);
+            }
+
+            index = 0;
+            for (Iterator it = begin; it != end; ++it, ++index) {
+                Edge edge(*it);
+                if ((options.removeSelfLoops && edge.from() == edge.to()) || (!keep.empty() && !keep[index])) {
+                    continue;
+                }
+                addEdge(edge);
+            }
+
+            if (options.sortNeighbors) {
+                for (Vertex& vertex: vertices_) {
+                    vertex.sortEdges();
+                }
+            }
         }
 
         void reset() {
+            if (epoch_.advance()) {
+                return;
+            }
             for (Vertex& vertex: vertices_) {
                 vertex.reset();
             }
@@ -472,61 +2659,51 @@ namespace sgl {
         VertexIterator vertexBegin() { return vertices_.begin(); }
         VertexIterator vertexEnd() { return vertices_.end(); }
 
-        EdgeIterator edgeBegin() { return  edges_.begin(); }
+        EdgeIterator edgeBegin() { return edges_.begin(); }
         EdgeIterator edgeEnd() { return edges_.end(); }
 
     private:
-        std::deque<Vertex> vertices_;
-        std::deque<Edge> edges_;
-    };
-
-    template <typename Data>
-    class APFlag {
-    private:
-        bool visited_ = false;
-    public:
-        using DType = size_t;
-        using LType = DType;
-        using IDType = DType;
-        DType dist;
-        LType low;
-        IDType id;
-        VectorVertex<Data, APFlag<Data>>* prev;
-
-        APFlag() : visited_{false}, dist{0}, low{0}, prev{nullptr} {}
-
-        void visit() { visited_ = true; }
-        bool visited() const { return visited_; }
-        void reset() {
-            visited_ = false;
-            dist = 0;
-            low = 0;
-            prev = nullptr;
-        }
+        using StorageType = typename Vertex::StorageType;
 
-        static DType zeroDist() {
-            return 0;
-        }
+        std::vector<Vertex, AllocatorType> vertices_;
+        std::vector<Edge, EdgeAllocatorType> edges_;
+        // Heap slot holding vertices_.data() and edges_.data(): it keeps its address when the
+        // graph is moved and is rewritten whenever an array reallocates, so vertices never go
+        // stale.
+        std::unique_ptr<StorageType> storage_;
+        GraphEpoch<typename Vertex::FlagType> epoch_;
 
-        static DType maxDist() {
-            return std::numeric_limits<DType>::max();
+        template <typename... Args>
+        void emplaceVertex(Args&&... args) {
+            if (storage_ == nullptr) {
+                storage_ = std::make_unique<StorageType>();
+            }
+            if constexpr (std::uses_allocator_v<Vertex, AllocatorType>) {
+                vertices_.emplace_back(std::allocator_arg, vertices_.get_allocator(), args...);
+            } else {
+                vertices_.emplace_back(args...);
+            }
+            vertices_.back().flags.id = vertices_.size() - 1;
+            vertices_.back().bindStorage(storage_.get());
+            epoch_.bind(vertices_.back().flags);
+            storage_->vertices = vertices_.data();
         }
     };
 
-    template <typename Data, typename Edge>
-    class APEFlag {
+    template <typename Data, typename Edge, typename Allocator = std::allocator<void>>
+    class APIFlag {
     private:
         bool visited_ = false;
     public:
         using DType = size_t;
         using LType = DType;
-        using IDType = DType;
+        using IDType = typename Edge::IDType;
         DType dist;
         LType low;
         IDType id;
-        VectorEdgeVertex<Data, APEFlag<Data, Edge>, Edge>* prev;
+        IndexedEdgeVertex<Data, APIFlag<Data, Edge, Allocator>, Edge, Allocator>* prev;
 
-        APEFlag() : visited_{false}, dist{0}, low{0}, prev{nullptr} {}
+        APIFlag() : visited_{false}, dist{0}, low{0}, id{0}, prev{nullptr} {}
 
         void visit() { visited_ = true; }
         bool visited() const { return visited_; }
@@ -2,6 +2,7 @@
 #define SGL_CONCEPTS_HPP
 
 #include <concepts>
+#include <cstddef>
 #include <iterator>
 
 namespace sgl {
@@ -19,6 +20,13 @@ namespace sgl {
         f.visited();
     };
 
+    template <typename Flag>
+    concept FlagEpoch =
+    FlagVisit<Flag> &&
+    requires(Flag f, const typename Flag::EpochType* epoch) {
+        f.bindEpoch(epoch);
+    };
+
     template <typename Flag>
     concept FlagID =
     IsFlag<Flag> &&
@@ -60,6 +68,23 @@ namespace sgl {
     FlagLow<Flag> &&
     FlagPrev<Flag>;
 
+    template <typename Map>
+    concept IsPropertyMap =
+    requires(Map m, size_t key) {
+        typename Map::ValueType;
+        m[key];
+        m.reset();
+        { m.size() } -> std::convertible_to<size_t>;
+    };
+
+    template <typename Map>
+    concept PropertyMapVisit =
+    requires(Map m, size_t key) {
+        m.visit(key);
+        { m.visited(key) } -> std::convertible_to<bool>;
+        m.reset();
+    };
+
     template <typename Edge>
     concept IsEdge =
     requires(Edge e) {
@@ -197,6 +222,19 @@ namespace sgl {
     IsGraph<Graph> &&
     Graph::DIRECTED == false;
 
+    // Vertices that also expose their adjacency as arcs holding the neighbour's ID and a copy
+    // of the edge value, so relaxation loops need not dereference edge records.
+    template <typename Vertex>
+    concept VertexArc =
+    VertexEdge<Vertex> &&
+    requires(Vertex v) {
+        typename Vertex::ArcIterator;
+        { v.arcBegin() } -> std::same_as<typename Vertex::ArcIterator>;
+        { v.arcEnd() } -> std::same_as<typename Vertex::ArcIterator>;
+        { v.arcBegin()->target } -> std::convertible_to<size_t>;
+        { v.arcBegin()->value } -> std::convertible_to<typename Vertex::EdgeType::ValueType>;
+    };
+
     template <typename Graph>
     concept GraphEdge =
     IsGraph<Graph> &&
@@ -1,31 +1,81 @@
 #ifndef SGL_FUNCTIONS_HPP
 #define SGL_FUNCTIONS_HPP
 
+#include <algorithm>
+#include <atomic>
 #include <concepts>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <queue>
 
 #include "sgl_concepts.hpp"
 #include "sgl_classes.hpp"
 
+// Promise that pointer parameters do not alias; expands to nothing on compilers without
+// an equivalent extension.
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define SGL_RESTRICT __restrict
+#else
+#define SGL_RESTRICT
+#endif
+
 namespace sgl {
+    // Iterative depth first traversal from root, driven by an explicit stack. visitedCallable
+    // and visitCallable read and set the visited state, discoverCallable gets every newly
+    // reached vertex together with its parent (nullptr for the root), finishCallable runs
+    // once all of the vertex's descendants are finished.
+    template <IsVertex Vertex, typename VisitedCallable, typename VisitCallable,
+              typename DiscoverCallable, typename FinishCallable>
+    requires std::predicate<VisitedCallable, Vertex&> &&
+             std::invocable<VisitCallable, Vertex&> &&
+             std::invocable<DiscoverCallable, Vertex&, Vertex*> &&
+             std::invocable<FinishCallable, Vertex&>
+    void deepFirstTraversal(Vertex& root, DepthFirstStack<Vertex>& stack, const VisitedCallable& visitedCallable,
+                            const VisitCallable& visitCallable, const DiscoverCallable& discoverCallable,
+                            const FinishCallable& finishCallable) {
+        std::invoke(visitCallable, root);
+        std::invoke(discoverCallable, root, nullptr);
+        stack.push(root);
+
+        while (!stack.empty()) {
+            Vertex* vertex = stack.top().first;
+            auto& neighbor = stack.top().second;
+
+            if (neighbor != vertex->vertexEnd()) {
+                Vertex& next = *neighbor;
+                ++neighbor;
+                if (!std::invoke(visitedCallable, next)) {
+                    std::invoke(visitCallable, next);
+                    std::invoke(discoverCallable, next, vertex);
+                    stack.push(next);
+                }
+            } else {
+                stack.pop();
+                std::invoke(finishCallable, *vertex);
+            }
+        }
+    }
+
+	template <VertexVisit Vertex, typename PreorderCallable, typename PostorderCallable>
+	requires std::invocable<PreorderCallable, Vertex&> &&
+	         std::invocable<PostorderCallable, Vertex&>
+	void deepFirstSearchVertex(Vertex& vertex, DepthFirstStack<Vertex>& stack,
+                               const PreorderCallable& preorderCallable, const PostorderCallable& postorderCallable) {
+        deepFirstTraversal(vertex, stack, [](Vertex& v) { return v.flags.visited(); }, [](Vertex& v) {
+            v.flags.visit();
+        }, [&preorderCallable](Vertex& v, Vertex*) {
+            std::invoke(preorderCallable, v);
+        }, postorderCallable);
+	}
+
 	template <VertexVisit Vertex, typename PreorderCallable, typename PostorderCallable>
 	requires std::invocable<PreorderCallable, Vertex&> &&
 	         std::invocable<PostorderCallable, Vertex&>
 	void deepFirstSearchVertex(Vertex& vertex, const PreorderCallable& preorderCallable,
                                const PostorderCallable& postorderCallable) {
-		
-		vertex.flags.visit();
-		std::invoke(preorderCallable, vertex);
-
-        for (auto neighbor = vertex.vertexBegin(); neighbor != vertex.vertexEnd(); ++neighbor) {
-            if (!neighbor->flags.visited()) {
-                deepFirstSearchVertex(*neighbor, preorderCallable, postorderCallable);
-			}
-		}
-		
-		std::invoke(postorderCallable, vertex);
+        DepthFirstStack<Vertex> stack = {};
+        deepFirstSearchVertex(vertex, stack, preorderCallable, postorderCallable);
 	}
 
     template <GraphVisit Graph, typename PreorderCallable, typename PostorderCallable>
@@ -33,13 +83,50 @@ namespace sgl {
 	         std::invocable<PostorderCallable, typename Graph::VertexType&>
 	void deepFirstSearch(Graph& graph, const PreorderCallable& preorderCallable,
                          const PostorderCallable& postorderCallable) {
+        DepthFirstStack<typename Graph::VertexType> stack(graph.vertexCount());
         for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
             if (!it->flags.visited()) {
-                deepFirstSearchVertex(*it, preorderCallable, postorderCallable);
+                deepFirstSearchVertex(*it, stack, preorderCallable, postorderCallable);
 			}
 		}
 	}
 
+    template <VertexID Vertex, PropertyMapVisit VisitMap, typename PreorderCallable, typename PostorderCallable>
+    requires std::invocable<PreorderCallable, Vertex&> &&
+             std::invocable<PostorderCallable, Vertex&>
+    void deepFirstSearchVertex(Vertex& vertex, VisitMap& visited, DepthFirstStack<Vertex>& stack,
+                               const PreorderCallable& preorderCallable, const PostorderCallable& postorderCallable) {
+        deepFirstTraversal(vertex, stack, [&visited](Vertex& v) {
+            return visited.visited(v.flags.id);
+        }, [&visited](Vertex& v) {
+            visited.visit(v.flags.id);
+        }, [&preorderCallable](Vertex& v, Vertex*) {
+            std::invoke(preorderCallable, v);
+        }, postorderCallable);
+    }
+
+    template <VertexID Vertex, PropertyMapVisit VisitMap, typename PreorderCallable, typename PostorderCallable>
+    requires std::invocable<PreorderCallable, Vertex&> &&
+             std::invocable<PostorderCallable, Vertex&>
+    void deepFirstSearchVertex(Vertex& vertex, VisitMap& visited, const PreorderCallable& preorderCallable,
+                               const PostorderCallable& postorderCallable) {
+        DepthFirstStack<Vertex> stack = {};
+        deepFirstSearchVertex(vertex, visited, stack, preorderCallable, postorderCallable);
+    }
+
+    template <GraphID Graph, PropertyMapVisit VisitMap, typename PreorderCallable, typename PostorderCallable>
+    requires std::invocable<PreorderCallable, typename Graph::VertexType&> &&
+             std::invocable<PostorderCallable, typename Graph::VertexType&>
+    void deepFirstSearch(Graph& graph, VisitMap& visited, const PreorderCallable& preorderCallable,
+                         const PostorderCallable& postorderCallable) {
+        DepthFirstStack<typename Graph::VertexType> stack(graph.vertexCount());
+        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
+            if (!visited.visited(it->flags.id)) {
+                deepFirstSearchVertex(*it, visited, stack, preorderCallable, postorderCallable);
+            }
+        }
+    }
+
     template <VertexVisit Vertex, typename PreorderCallable, typename PostorderCallable>
     requires std::invocable<PreorderCallable, Vertex&> &&
              std::invocable<PostorderCallable, Vertex&>
@@ -80,6 +167,203 @@ namespace sgl {
        }
    }
 
+    template <VertexID Vertex, PropertyMapVisit VisitMap, typename PreorderCallable, typename PostorderCallable>
+    requires std::invocable<PreorderCallable, Vertex&> &&
+             std::invocable<PostorderCallable, Vertex&>
+    void breadthFirstSearchVertex(Vertex& vertex, VisitMap& visited, const PreorderCallable& preorderCallable,
+                                  const PostorderCallable& postorderCallable) {
+
+        std::queue<Vertex*> queue = {};
+
+        queue.push(&vertex);
+        visited.visit(vertex.flags.id);
+
+        while (!queue.empty()) {
+            Vertex* ptr = queue.front();
+            queue.pop();
+
+            std::invoke(preorderCallable, *ptr);
+
+            for (auto it = ptr->vertexBegin(); it != ptr->vertexEnd(); ++it) {
+                if (!visited.visited(it->flags.id)) {
+                    visited.visit(it->flags.id);
+                    queue.push(&(*it));
+                }
+            }
+
+            std::invoke(postorderCallable, *ptr);
+        }
+    }
+
+    template <GraphID Graph, PropertyMapVisit VisitMap, typename PreorderCallable, typename PostorderCallable>
+    requires std::invocable<PreorderCallable, typename Graph::VertexType&> &&
+             std::invocable<PostorderCallable, typename Graph::VertexType&>
+    void breadthFirstSearch(Graph& graph, VisitMap& visited, const PreorderCallable& preorderCallable,
+                            const PostorderCallable& postorderCallable) {
+        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
+            if (!visited.visited(it->flags.id)) {
+                breadthFirstSearchVertex(*it, visited, preorderCallable, postorderCallable);
+            }
+        }
+    }
+
+    // Breadth first search that switches to bottom-up steps, in which every unvisited vertex
+    // looks for any parent in the frontier bitmap, once the frontier's edges outnumber the
+    // unexplored edges divided by alpha, and back to top-down steps once the frontier shrinks
+    // below vertexCount / beta. Bottom-up steps read adjacency lists as incoming edges, so the
+    // graph has to be undirected. Returns parents (the source is its own parent) and depths;
+    // unreached vertices keep invalidID() and the maximal depth.
+    template <GraphID Graph>
+    requires GraphUndirected<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType>
+    std::pair<std::vector<typename Graph::IDType>, std::vector<size_t>>
+    directionOptimizingBreadthFirstSearch(Graph& graph, typename Graph::VertexType& source,
+                                          size_t alpha = 15, size_t beta = 18) {
+        using IDType = typename Graph::IDType;
+
+        size_t n = graph.vertexCount();
+        std::vector<IDType> parent(n, invalidID<IDType>());
+        std::vector<size_t> depth(n, std::numeric_limits<size_t>::max());
+
+        IDType sid = source.flags.id;
+        parent[sid] = sid;
+        depth[sid] = 0;
+
+        size_t unexplored = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unexplored += graph[i].degree();
+        }
+
+        std::vector<IDType> frontier = {sid};
+        std::vector<IDType> next = {};
+        BitsetVisitMap front(n);
+        BitsetVisitMap nextFront(n);
+        size_t frontierEdges = source.degree();
+        size_t frontierSize = 1;
+        size_t previousSize = 0;
+        bool bottomUp = false;
+        unexplored -= frontierEdges;
+
+        for (size_t level = 1; frontierSize > 0; ++level) {
+            if (!bottomUp && frontierEdges > unexplored / alpha) {
+                bottomUp = true;
+                front.reset();
+                for (IDType id: frontier) {
+                    front.visit(id);
+                }
+            } else if (bottomUp && frontierSize < previousSize && frontierSize < n / beta) {
+                bottomUp = false;
+                frontier.clear();
+                for (size_t i = 0; i < n; ++i) {
+                    if (front.visited(i)) {
+                        frontier.push_back(static_cast<IDType>(i));
+                    }
+                }
+            }
+
+            previousSize = frontierSize;
+            frontierEdges = 0;
+            if (bottomUp) {
+                frontierSize = 0;
+                nextFront.reset();
+                for (size_t i = 0; i < n; ++i) {
+                    if (parent[i] != invalidID<IDType>()) {
+                        continue;
+                    }
+                    for (auto it = graph[i].vertexBegin(); it != graph[i].vertexEnd(); ++it) {
+                        if (front.visited(it->flags.id)) {
+                            parent[i] = it->flags.id;
+                            depth[i] = level;
+                            nextFront.visit(i);
+                            frontierEdges += graph[i].degree();
+                            ++frontierSize;
+                            break;
+                        }
+                    }
+                }
+                std::swap(front, nextFront);
+            } else {
+                next.clear();
+                for (IDType id: frontier) {
+                    for (auto it = graph[id].vertexBegin(); it != graph[id].vertexEnd(); ++it) {
+                        IDType nid = it->flags.id;
+                        if (parent[nid] == invalidID<IDType>()) {
+                            parent[nid] = id;
+                            depth[nid] = level;
+                            next.push_back(nid);
+                            frontierEdges += it->degree();
+                        }
+                    }
+                }
+                std::swap(frontier, next);
+                frontierSize = frontier.size();
+            }
+            unexplored -= frontierEdges;
+        }
+
+        return std::pair(std::move(parent), std::move(depth));
+    }
+
+    // Level-synchronous breadth first search: every frontier is split among the pool's threads,
+    // which claim neighbours with a compare-and-swap on their parent and collect them in
+    // per-thread buffers. Depths do not depend on scheduling; a vertex reachable from several
+    // frontier vertices may get any of them as its parent. Vertex flags are not touched.
+    template <GraphID Graph>
+    requires GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType>
+    std::pair<std::vector<typename Graph::IDType>, std::vector<size_t>>
+    parallelBreadthFirstSearch(Graph& graph, typename Graph::VertexType& source, ThreadPool& pool) {
+        using IDType = typename Graph::IDType;
+
+        size_t n = graph.vertexCount();
+        std::vector<std::atomic<IDType>> claimed(n);
+        std::vector<IDType> parent(n);
+        std::vector<size_t> depth(n, std::numeric_limits<size_t>::max());
+
+        pool.parallelFor(0, n, [&claimed](size_t i, size_t) {
+            claimed[i].store(invalidID<IDType>(), std::memory_order_relaxed);
+        });
+
+        IDType sid = source.flags.id;
+        claimed[sid].store(sid, std::memory_order_relaxed);
+        depth[sid] = 0;
+
+        std::vector<IDType> frontier = {sid};
+        std::vector<std::vector<IDType>> buffers(pool.threadCount());
+        std::vector<size_t> offsets(pool.threadCount() + 1, 0);
+
+        for (size_t level = 1; !frontier.empty(); ++level) {
+            pool.parallelFor(0, frontier.size(), [&](size_t index, size_t thread) {
+                IDType id = frontier[index];
+                for (auto it = graph[id].vertexBegin(); it != graph[id].vertexEnd(); ++it) {
+                    IDType nid = it->flags.id;
+                    IDType expected = invalidID<IDType>();
+                    if (claimed[nid].load(std::memory_order_relaxed) == expected &&
+                        claimed[nid].compare_exchange_strong(expected, id, std::memory_order_relaxed)) {
+                        depth[nid] = level;
+                        buffers[thread].push_back(nid);
+                    }
+                }
+            }, 64);
+
+            for (size_t thread = 0; thread < buffers.size(); ++thread) {
+                offsets[thread + 1] = offsets[thread] + buffers[thread].size();
+            }
+            frontier.resize(offsets.back());
+            pool.runOnEachThread([&buffers, &offsets, &frontier](size_t thread) {
+                std::copy(buffers[thread].begin(), buffers[thread].end(), frontier.begin() + offsets[thread]);
+                buffers[thread].clear();
+            });
+        }
+
+        pool.parallelFor(0, n, [&claimed, &parent](size_t i, size_t) {
+            parent[i] = claimed[i].load(std::memory_order_relaxed);
+        });
+
+        return std::pair(std::move(parent), std::move(depth));
+    }
+
     template <GraphID InputGraph, GraphDirected OutputGraph>
     requires std::same_as<typename  InputGraph::VertexType, typename OutputGraph::VertexType> &&
              GraphDirected<InputGraph>
@@ -112,6 +396,7 @@ namespace sgl {
 		
 		auto graphT = transponse<InputGraph, RandomAccessGraph<Vertex, InputGraph::DIRECTED>>(graph);
         std::vector<std::vector<IDType>> output = {};
+        DepthFirstStack<Vertex> stack(graphT.vertexCount());
 		
 		for (auto it = rbegin(indexes); it != rend(indexes); ++it) {
 			Vertex* v = &graphT[*it];
@@ -119,7 +404,7 @@ namespace sgl {
 			if (!v->flags.visited()) {
                 output.push_back(std::vector<IDType>());
                 std::vector<IDType>& tree = output.back();
-                deepFirstSearchVertex(*v, [&tree](Vertex& ve) {
+                deepFirstSearchVertex(*v, stack, [&tree](Vertex& ve) {
                     tree.push_back(ve.flags.id);
                 }, [](Vertex& v) {});
 			}
@@ -128,199 +413,1827 @@ namespace sgl {
 		return output;
 	}
 
-    template <VertexAP Vertex, HasPushBack Container>
-    requires std::same_as<Vertex*, typename Container::value_type> &&
-             std::integral<typename Vertex::FlagType::DType>
-    void articulationPoints(Vertex& v, Container& container, typename Vertex::FlagType::DType depth) {
-        size_t childCount = 0;
-        bool isArticulation = false;
-        v.flags.visit();
-        v.flags.dist = depth;
-        v.flags.low = depth;
+    // Tarjan's algorithm in a single iterative depth first traversal, without building the
+    // transposed graph. Discovery orders, low links and component labels live in three flat
+    // arrays; a vertex is on the Tarjan stack iff it is discovered but not yet labelled.
+    // Components are numbered in the order they complete, which is a reverse topological
+    // order of the condensation. Returns the component count and every vertex's label.
+    template <GraphID Graph>
+    requires GraphDirected<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType>
+    std::pair<size_t, std::vector<typename Graph::IDType>> stronglyConnectedComponentLabels(Graph& graph) {
+        using Vertex = typename Graph::VertexType;
+        using IDType = typename Graph::IDType;
 
-        for (auto it = v.vertexBegin(); it != v.vertexEnd(); ++it) {
-            if (!it->flags.visited()) {
-                it->flags.prev = &v;
-                ++childCount;
-                articulationPoints(*it, container, depth + 1);
-                if (it->flags.low >= v.flags.dist) {
-                    isArticulation = true;
+        size_t n = graph.vertexCount();
+        std::vector<IDType> order(n, invalidID<IDType>());
+        std::vector<IDType> low(n);
+        std::vector<IDType> label(n, invalidID<IDType>());
+        std::vector<IDType> tarjanStack = {};
+        DepthFirstStack<Vertex> frames = {};
+        IDType counter = 0;
+        size_t count = 0;
+
+        auto discover = [&](Vertex& vertex) {
+            IDType id = vertex.flags.id;
+            order[id] = counter;
+            low[id] = counter;
+            ++counter;
+            tarjanStack.push_back(id);
+            frames.push(vertex);
+        };
+
+        for (size_t root = 0; root < n; ++root) {
+            if (order[root] != invalidID<IDType>()) {
+                continue;
+            }
+
+            discover(graph[root]);
+            while (!frames.empty()) {
+                auto& [vertex, it] = frames.top();
+                IDType id = vertex->flags.id;
+                if (it != vertex->vertexEnd()) {
+                    Vertex& next = *it;
+                    ++it;
+                    IDType nid = next.flags.id;
+                    if (order[nid] == invalidID<IDType>()) {
+                        discover(next);
+                    } else if (label[nid] == invalidID<IDType>()) {
+                        low[id] = std::min(low[id], order[nid]);
+                    }
+                    continue;
+                }
+
+                frames.pop();
+                if (low[id] == order[id]) {
+                    IDType member;
+                    do {
+                        member = tarjanStack.back();
+                        tarjanStack.pop_back();
+                        label[member] = static_cast<IDType>(count);
+                    } while (member != id);
+                    ++count;
+                }
+                if (!frames.empty()) {
+                    IDType parent = frames.top().first->flags.id;
+                    low[parent] = std::min(low[parent], low[id]);
                 }
-                v.flags.low = v.flags.low < it->flags.low ? v.flags.low : it->flags.low;
-            } else if (&(*it) != v.flags.prev) {
-                v.flags.low = v.flags.low < it->flags.dist ? v.flags.low : it->flags.dist;
             }
         }
 
-        if ((v.flags.prev != nullptr && isArticulation) || (v.flags.prev == nullptr && childCount > 1)) {
-            container.push_back(&v);
-        }
+        return std::pair(count, std::move(label));
     }
 
-    template <GraphAP Graph, HasPushBack Container>
-    requires std::same_as<typename Graph::VertexType*, typename Container::value_type> &&
-             std::integral<typename Graph::VertexType::FlagType::DType>
-    void graphArticulationPoints(Graph& graph, Container& container) {
-        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
-            if (!it->flags.visited()) {
-                articulationPoints(*it, container, Graph::VertexType::FlagType::zeroDist());
+    // Renumbers labels that are vertex IDs to 0..count-1 in order of each label's first
+    // vertex, so results do not depend on which vertex represented a component. Returns count.
+    template <std::integral IDType>
+    size_t denseLabels(std::vector<IDType>& labels) {
+        std::vector<IDType> dense(labels.size(), invalidID<IDType>());
+        size_t count = 0;
+        for (IDType& label: labels) {
+            if (dense[label] == invalidID<IDType>()) {
+                dense[label] = static_cast<IDType>(count++);
             }
+            label = dense[label];
         }
-
-        graph.reset();
+        return count;
     }
 
-    template <GraphEdge Graph>
-    requires GraphVisit<Graph> &&
-             GraphDist<Graph> &&
-             FlagPrev<typename Graph::VertexType::FlagType> &&
-             EdgeWeight<typename Graph::EdgeType>
-    void dijkstra(Graph& graph, typename Graph::VertexType& start) {
-        using Vertex = typename Graph::VertexType;
-        using Edge = typename Graph::EdgeType;
+    // Parallel SCC decomposition in three steps over the vertices not yet assigned. Trimming
+    // assigns vertices without live in- or out-neighbours, repeated while a round removes at
+    // least 1/32 of them. One forward-backward search from the pivot with the largest degree
+    // product then takes the giant component. Colouring finishes the tail: the largest vertex
+    // ID reaching each vertex is propagated forward, and every vertex that keeps its own colour
+    // collects its component by a backward search within that colour. Incoming edges are built
+    // once in compressed rows, and per-vertex component slots are claimed with atomics.
+    // Returns the component count and labels numbered in order of each component's smallest
+    // vertex, so they do not depend on scheduling.
+    template <GraphID Graph>
+    requires GraphDirected<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType>
+    std::pair<size_t, std::vector<typename Graph::IDType>>
+    parallelStronglyConnectedComponents(Graph& graph, ThreadPool& pool) {
+        using IDType = typename Graph::IDType;
 
-        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
-            it->flags.dist = Vertex::FlagType::maxDist();
-            it->flags.prev = nullptr;
+        size_t n = graph.vertexCount();
+        constexpr auto relaxed = std::memory_order_relaxed;
+
+        std::vector<std::atomic<size_t>> cursor(n + 1);
+        pool.parallelFor(0, n + 1, [&cursor](size_t i, size_t) { cursor[i].store(0, relaxed); });
+        pool.parallelFor(0, n, [&graph, &cursor](size_t id, size_t) {
+            for (auto it = graph[id].vertexBegin(); it != graph[id].vertexEnd(); ++it) {
+                cursor[static_cast<size_t>(it->flags.id) + 1].fetch_add(1, relaxed);
+            }
+        }, 64);
+        std::vector<size_t> inOffsets(n + 1, 0);
+        for (size_t i = 1; i <= n; ++i) {
+            inOffsets[i] = inOffsets[i - 1] + cursor[i].load(relaxed);
         }
+        pool.parallelFor(0, n, [&cursor, &inOffsets](size_t i, size_t) { cursor[i].store(inOffsets[i], relaxed); });
+        std::vector<IDType> inSources(inOffsets[n]);
+        pool.parallelFor(0, n, [&graph, &cursor, &inSources](size_t id, size_t) {
+            for (auto it = graph[id].vertexBegin(); it != graph[id].vertexEnd(); ++it) {
+                inSources[cursor[it->flags.id].fetch_add(1, relaxed)] = static_cast<IDType>(id);
+            }
+        }, 64);
 
-        start.flags.dist = Vertex::FlagType::zeroDist();
-        auto queue = std::priority_queue([](const Vertex* a, const Vertex* b) {
-            return a->flags.dist > b->flags.dist;
-            }, std::vector<Vertex*>());
+        std::vector<std::atomic<IDType>> component(n);
+        std::vector<std::atomic<IDType>> colour(n);
+        std::vector<std::atomic<size_t>> stamp(n);
+        std::vector<IDType> active(n);
+        pool.parallelFor(0, n, [&](size_t i, size_t) {
+            component[i].store(invalidID<IDType>(), relaxed);
+            stamp[i].store(0, relaxed);
+            active[i] = static_cast<IDType>(i);
+        });
 
-        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
-            queue.push(&(*it));
-        }
+        auto alive = [&component](IDType id) { return component[id].load(relaxed) == invalidID<IDType>(); };
 
-        while (!queue.empty()) {
-            Vertex* vert = queue.top();
-            queue.pop();
-            if (!vert->flags.visited()) {
-                vert->flags.visit();
-                for (auto neighbour = vert->pairBegin(); neighbour != vert->pairEnd(); ++neighbour) {
-                    Vertex& nv = *std::get<0>(*neighbour);
-                    Edge& ne = *std::get<1>(*neighbour);
-                    if (nv.flags.dist > vert->flags.dist + ne.value.weight()) {
-                        nv.flags.dist = vert->flags.dist + ne.value.weight();
-                        nv.flags.prev = vert;
-                        queue.push(&nv);
+        std::vector<std::vector<IDType>> buffers(pool.threadCount());
+        std::vector<size_t> offsets(pool.threadCount() + 1, 0);
+        auto collect = [&buffers, &offsets, &pool](std::vector<IDType>& into) {
+            for (size_t thread = 0; thread < buffers.size(); ++thread) {
+                offsets[thread + 1] = offsets[thread] + buffers[thread].size();
+            }
+            into.resize(offsets.back());
+            pool.runOnEachThread([&buffers, &offsets, &into](size_t thread) {
+                std::copy(buffers[thread].begin(), buffers[thread].end(), into.begin() + offsets[thread]);
+                buffers[thread].clear();
+            });
+        };
+
+        auto keep = [&](const auto& predicate) {
+            pool.parallelFor(0, active.size(), [&](size_t index, size_t thread) {
+                if (predicate(active[index])) {
+                    buffers[thread].push_back(active[index]);
+                }
+            });
+            collect(active);
+        };
+
+        // Level-synchronous search: claim(id, next) decides whether next joins the frontier.
+        size_t level = 0;
+        auto expand = [&](std::vector<IDType>& frontier, bool forward, const auto& claim) {
+            while (!frontier.empty()) {
+                ++level;
+                pool.parallelFor(0, frontier.size(), [&](size_t index, size_t thread) {
+                    IDType id = frontier[index];
+                    if (forward) {
+                        for (auto it = graph[id].vertexBegin(); it != graph[id].vertexEnd(); ++it) {
+                            if (claim(id, static_cast<IDType>(it->flags.id))) {
+                                buffers[thread].push_back(it->flags.id);
+                            }
+                        }
+                    } else {
+                        for (size_t k = inOffsets[id]; k < inOffsets[static_cast<size_t>(id) + 1]; ++k) {
+                            if (claim(id, inSources[k])) {
+                                buffers[thread].push_back(inSources[k]);
+                            }
+                        }
                     }
+                }, 64);
+                collect(frontier);
+            }
+        };
+
+        while (!active.empty()) {
+            size_t before = active.size();
+            pool.parallelFor(0, active.size(), [&](size_t index, size_t) {
+                IDType id = active[index];
+                bool hasOut = false;
+                for (auto it = graph[id].vertexBegin(); it != graph[id].vertexEnd() && !hasOut; ++it) {
+                    hasOut = it->flags.id != id && alive(it->flags.id);
                 }
+                bool hasIn = false;
+                for (size_t k = inOffsets[id]; k < inOffsets[static_cast<size_t>(id) + 1] && !hasIn; ++k) {
+                    hasIn = inSources[k] != id && alive(inSources[k]);
+                }
+                if (!hasOut || !hasIn) {
+                    component[id].store(id, relaxed);
+                }
+            }, 256);
+            keep(alive);
+            if ((before - active.size()) * 32 < before) {
+                break;
             }
         }
-    }
-
-    template <GraphEdge Graph, HasPushBack Container>
-    requires std::same_as<typename Graph::EdgeType*, typename Container::value_type> &&
-             GraphVisit<Graph> &&
-             EdgeWeight<typename Graph::EdgeType>
-    void prim(Graph& graph, Container& container) {
-        using Vertex = typename Graph::VertexType;
-        using Edge = typename Graph::EdgeType;
-        using Pair = typename Vertex::PairType;
 
-        Vertex& v1 = *graph.vertexBegin();
-        v1.flags.visit();
+        if (!active.empty()) {
+            std::vector<std::pair<size_t, IDType>> best(pool.threadCount(), std::pair(0, active[0]));
+            pool.parallelFor(0, active.size(), [&](size_t index, size_t thread) {
+                IDType id = active[index];
+                size_t score = (graph[id].degree() + 1) * (inOffsets[static_cast<size_t>(id) + 1] - inOffsets[id] + 1);
+                if (score > std::get<0>(best[thread])) {
+                    best[thread] = std::pair(score, id);
+                }
+            });
+            IDType pivot = std::get<1>(*std::max_element(best.begin(), best.end()));
 
-        auto queue = std::priority_queue([](const Pair* a, const Pair* b) {
-            return std::get<1>(*a)->value.weight() > std::get<1>(*b)->value.weight();
-        }, std::vector<Pair*>());
+            // Reached forward is recorded as colour == pivot, reached backward as stamp == 1.
+            pool.parallelFor(0, active.size(), [&](size_t index, size_t) {
+                colour[active[index]].store(invalidID<IDType>(), relaxed);
+            });
+            colour[pivot].store(pivot, relaxed);
+            std::vector<IDType> frontier = {pivot};
+            expand(frontier, true, [&](IDType, IDType next) {
+                IDType expected = invalidID<IDType>();
+                return alive(next) && colour[next].load(relaxed) == expected &&
+                       colour[next].compare_exchange_strong(expected, pivot, relaxed);
+            });
 
-        for (auto it = v1.pairBegin(); it != v1.pairEnd(); ++it) {
-            queue.push(&(*it));
+            component[pivot].store(pivot, relaxed);
+            frontier = {pivot};
+            expand(frontier, false, [&](IDType, IDType next) {
+                IDType expected = invalidID<IDType>();
+                return colour[next].load(relaxed) == pivot &&
+                       component[next].compare_exchange_strong(expected, pivot, relaxed);
+            });
+            keep(alive);
         }
 
-        while (!queue.empty()) {
-            Pair* pair = queue.top();
-            Vertex* vert = std::get<0>(*pair);
-            Edge* edge = std::get<1>(*pair);
-            queue.pop();
+        while (!active.empty()) {
+            pool.parallelFor(0, active.size(), [&](size_t index, size_t) {
+                colour[active[index]].store(active[index], relaxed);
+            });
 
-            if (!vert->flags.visited()) {
-                vert->flags.visit();
-                container.push_back(edge);
-                for (auto it = vert->pairBegin(); it != vert->pairEnd(); ++it) {
-                    if (!std::get<0>(*it)->flags.visited()) {
-                        queue.push(&(*it));
-                    }
+            std::vector<IDType> frontier = active;
+            expand(frontier, true, [&](IDType id, IDType next) {
+                IDType raised = colour[id].load(relaxed);
+                if (!alive(next)) {
+                    return false;
                 }
-            }
+                IDType current = colour[next].load(relaxed);
+                while (current < raised && !colour[next].compare_exchange_weak(current, raised, relaxed)) {}
+                return current < raised && stamp[next].exchange(level, relaxed) != level;
+            });
+
+            std::vector<IDType> roots = {};
+            pool.parallelFor(0, active.size(), [&](size_t index, size_t thread) {
+                if (colour[active[index]].load(relaxed) == active[index]) {
+                    buffers[thread].push_back(active[index]);
+                }
+            });
+            collect(roots);
+            pool.parallelFor(0, roots.size(), [&](size_t index, size_t) {
+                component[roots[index]].store(roots[index], relaxed);
+            });
+
+            expand(roots, false, [&](IDType id, IDType next) {
+                IDType root = colour[id].load(relaxed);
+                IDType expected = invalidID<IDType>();
+                return colour[next].load(relaxed) == root && component[next].load(relaxed) == expected &&
+                       component[next].compare_exchange_strong(expected, root, relaxed);
+            });
+            keep(alive);
         }
-    }
 
-    template <typename Weight, IsVertex Vertex, typename IDType>
-    void setMatrixPair(std::vector<std::vector<std::pair<Weight, Vertex*>>>& matrix, IDType from, IDType to,
-                       Weight weight, Vertex* vertex) {
-        std::get<0>(matrix[from][to]) = weight;
-        std::get<1>(matrix[from][to]) = vertex;
+        std::vector<IDType> label(n);
+        pool.parallelFor(0, n, [&component, &label](size_t v, size_t) { label[v] = component[v].load(relaxed); });
+        size_t count = denseLabels(label);
+
+        return std::pair(count, std::move(label));
     }
 
-    template <GraphEdge Graph>
-    requires GraphID<Graph> &&
-             GraphDirected<Graph> &&
+    // Hopcroft-Tarjan biconnectivity in one iterative depth first traversal, on plain IDs
+    // instead of FlagAP vertices. When a child's subtree cannot reach above its parent, the
+    // vertices stacked since the child form a block with the parent, and each of them records
+    // the block of its tree edge. Every edge shares the block of the tree edge into its deeper
+    // endpoint, which labels all adjacency entries in a final pass. Only the first entry back
+    // to the parent is treated as the tree edge, so parallel edges are never bridges. Cut
+    // vertices are sorted by ID; bridges are (parent, child) pairs in the order found.
+    template <GraphID Graph>
+    requires GraphUndirected<Graph> &&
              GraphRandomlyAccessible<Graph> &&
-             EdgeWeight<typename Graph::EdgeType>
-    std::vector<std::vector<std::pair<typename Graph::EdgeType::ValueType::WeightType, typename Graph::VertexType*>>>
-    floydWarshall(Graph& graph) {
+             std::integral<typename Graph::IDType>
+    BiconnectedComponents<typename Graph::IDType> biconnectedComponents(Graph& graph) {
         using Vertex = typename Graph::VertexType;
-        using Edge   = typename Graph::EdgeType;
-        using Weight = typename Graph::EdgeType::ValueType::WeightType;
         using IDType = typename Graph::IDType;
+        using Result = BiconnectedComponents<IDType>;
 
-        std::vector<std::vector<std::pair<Weight, Vertex*>>> matrix =
-                {graph.vertexCount(), {graph.vertexCount(), {Edge::ValueType::maxWeight(), nullptr}}};
-
-        for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
-            setMatrixPair(matrix, it->from(), it->to(), it->value.weight(), &graph[it->from()]);
-        }
+        size_t n = graph.vertexCount();
+        Result result = {};
+        std::vector<IDType> order(n, invalidID<IDType>());
+        std::vector<IDType> low(n);
+        std::vector<IDType> parent(n, invalidID<IDType>());
+        std::vector<bool> parentSkipped(n, false);
+        std::vector<bool> cut(n, false);
+        std::vector<size_t> treeBlock(n, Result::NO_BLOCK);
+        std::vector<IDType> subtree = {};
+        DepthFirstStack<Vertex> frames = {};
+        IDType counter = 0;
 
-        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
-            setMatrixPair(matrix, it->flags.id, it->flags.id, Edge::ValueType::zeroWeight(), &(*it));
-        }
+        for (size_t root = 0; root < n; ++root) {
+            if (order[root] != invalidID<IDType>()) {
+                continue;
+            }
 
-        for (size_t k = 0; k < graph.vertexCount(); ++k) {
-            for (IDType i = 0; i < graph.vertexCount(); ++i) {
-                for (IDType j = 0; j < graph.vertexCount(); ++j) {
-                    Weight detour;
-                    if (std::get<0>(matrix[i][k]) == Edge::ValueType::maxWeight() ||
-                        std::get<0>(matrix[k][j]) == Edge::ValueType::maxWeight()) {
-                        detour = Edge::ValueType::maxWeight();
+            size_t rootChildren = 0;
+            order[root] = counter;
+            low[root] = counter;
+            ++counter;
+            frames.push(graph[root]);
+            while (!frames.empty()) {
+                auto& [vertex, it] = frames.top();
+                IDType id = vertex->flags.id;
+                if (it != vertex->vertexEnd()) {
+                    Vertex& next = *it;
+                    ++it;
+                    IDType nid = next.flags.id;
+                    if (nid == id) {
+                        continue;
+                    } else if (nid == parent[id] && !parentSkipped[id]) {
+                        parentSkipped[id] = true;
+                    } else if (order[nid] == invalidID<IDType>()) {
+                        order[nid] = counter;
+                        low[nid] = counter;
+                        ++counter;
+                        parent[nid] = id;
+                        subtree.push_back(nid);
+                        rootChildren += static_cast<size_t>(id) == root ? 1 : 0;
+                        frames.push(next);
                     } else {
-                        detour = std::get<0>(matrix[i][k]) + std::get<0>(matrix[k][j]);
+                        low[id] = std::min(low[id], order[nid]);
                     }
-                    if (std::get<0>(matrix[i][j]) > detour) {
-                        setMatrixPair(matrix, i, j, detour, std::get<1>(matrix[k][j]));
+                    continue;
+                }
+
+                frames.pop();
+                if (frames.empty()) {
+                    break;
+                }
+                IDType up = parent[id];
+                low[up] = std::min(low[up], low[id]);
+                if (low[id] >= order[up]) {
+                    IDType member;
+                    do {
+                        member = subtree.back();
+                        subtree.pop_back();
+                        treeBlock[member] = result.blockCount;
+                    } while (member != id);
+                    ++result.blockCount;
+                    cut[up] = cut[up] || static_cast<size_t>(up) != root;
+                    if (low[id] > order[up]) {
+                        result.bridges.emplace_back(up, id);
                     }
                 }
             }
+            cut[root] = rootChildren > 1;
         }
 
-        return matrix;
+        result.arcOffsets.assign(n + 1, 0);
+        for (size_t v = 0; v < n; ++v) {
+            if (cut[v]) {
+                result.cutVertices.push_back(static_cast<IDType>(v));
+            }
+            size_t degree = 0;
+            for (auto it = graph[v].vertexBegin(); it != graph[v].vertexEnd(); ++it) {
+                IDType w = it->flags.id;
+                size_t deeper = order[v] > order[w] ? v : static_cast<size_t>(w);
+                result.arcBlocks.push_back(static_cast<size_t>(w) == v ? Result::NO_BLOCK : treeBlock[deeper]);
+                ++degree;
+            }
+            result.arcOffsets[v + 1] = result.arcOffsets[v] + degree;
+        }
+
+        return result;
     }
 
-    template <GraphEdge Graph, IsVertex Vertex, typename Flow>
-    requires EdgeFlow<typename Graph::EdgeType> &&
-             GraphDirected<Graph> &&
-             GraphID<Graph> &&
-             std::same_as<typename Graph::VertexType, Vertex> &&
-             std::same_as<typename Graph::EdgeType::ValueType::FlowType, Flow>
-    Flow edmondsKarp(Graph& graph, Vertex& source, Vertex& target) {
-        using Edge = typename Graph::EdgeType;
-        Flow flow = Edge::ValueType::zeroFlow();
+    // Connected components of an undirected graph by breadth first searches over IDs. Returns
+    // the component count and labels numbered in order of each component's smallest vertex.
+    template <GraphID Graph>
+    requires GraphUndirected<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType>
+    std::pair<size_t, std::vector<typename Graph::IDType>> connectedComponents(Graph& graph) {
+        using IDType = typename Graph::IDType;
 
-        while (true) {
-            std::queue<Vertex *> queue = {};
-            queue.push(&source);
-            std::vector<Edge *> pred = {graph.vertexCount(), nullptr};
+        size_t n = graph.vertexCount();
+        std::vector<IDType> label(n, invalidID<IDType>());
+        std::vector<IDType> queue(n);
+        size_t count = 0;
 
-            while (!queue.empty() && pred[target.flags.id] == nullptr) {
-                Vertex *ptr = queue.front();
-                queue.pop();
+        for (size_t root = 0; root < n; ++root) {
+            if (label[root] != invalidID<IDType>()) {
+                continue;
+            }
 
-                for (auto it = ptr->pairBegin(); it != ptr->pairEnd(); ++it) {
-                    Vertex &nv = *std::get<0>(*it);
-                    Edge &ne = *std::get<1>(*it);
+            size_t head = 0;
+            size_t tail = 0;
+            label[root] = static_cast<IDType>(count);
+            queue[tail++] = static_cast<IDType>(root);
+            while (head < tail) {
+                IDType id = queue[head++];
+                for (auto it = graph[id].vertexBegin(); it != graph[id].vertexEnd(); ++it) {
+                    IDType nid = it->flags.id;
+                    if (label[nid] == invalidID<IDType>()) {
+                        label[nid] = static_cast<IDType>(count);
+                        queue[tail++] = nid;
+                    }
+                }
+            }
+            ++count;
+        }
+
+        return std::pair(count, std::move(label));
+    }
+
+    // Afforest connected components on a lock-free union-find whose links always point to
+    // smaller IDs. The first neighbourRounds neighbours of every vertex are linked and the
+    // forest compressed first; a sample of 1024 vertices then names the likely giant
+    // component, whose vertices skip their remaining neighbours. Edges from the other side
+    // still link every vertex outside it. Labels are numbered as in connectedComponents().
+    template <GraphID Graph>
+    requires GraphUndirected<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType>
+    std::pair<size_t, std::vector<typename Graph::IDType>>
+    afforestConnectedComponents(Graph& graph, ThreadPool& pool, size_t neighbourRounds = 2) {
+        using IDType = typename Graph::IDType;
+
+        size_t n = graph.vertexCount();
+        constexpr auto relaxed = std::memory_order_relaxed;
+        std::vector<std::atomic<IDType>> parent(n);
+        pool.parallelFor(0, n, [&parent](size_t v, size_t) { parent[v].store(static_cast<IDType>(v), relaxed); });
+
+        auto link = [&parent](IDType u, IDType v) {
+            IDType a = parent[u].load(relaxed);
+            IDType b = parent[v].load(relaxed);
+            while (a != b) {
+                IDType high = std::max(a, b);
+                IDType low = std::min(a, b);
+                IDType highParent = parent[high].load(relaxed);
+                if (highParent == low) {
+                    break;
+                }
+                IDType expected = high;
+                if (highParent == high && parent[high].compare_exchange_strong(expected, low, relaxed)) {
+                    break;
+                }
+                a = parent[parent[high].load(relaxed)].load(relaxed);
+                b = parent[low].load(relaxed);
+            }
+        };
+
+        auto compress = [&parent, &pool, n]() {
+            pool.parallelFor(0, n, [&parent](size_t v, size_t) {
+                IDType current = parent[v].load(relaxed);
+                for (IDType up = parent[current].load(relaxed); current != up; up = parent[current].load(relaxed)) {
+                    current = up;
+                }
+                parent[v].store(current, relaxed);
+            });
+        };
+
+        for (size_t round = 0; round < neighbourRounds; ++round) {
+            pool.parallelFor(0, n, [&](size_t v, size_t) {
+                auto it = graph[v].vertexBegin();
+                for (size_t k = 0; k < round && it != graph[v].vertexEnd(); ++k) {
+                    ++it;
+                }
+                if (it != graph[v].vertexEnd()) {
+                    link(static_cast<IDType>(v), it->flags.id);
+                }
+            }, 256);
+            compress();
+        }
+
+        IDType giant = invalidID<IDType>();
+        if (n > 0) {
+            std::vector<IDType> sample(std::min<size_t>(n, 1024));
+            std::uint32_t state = 2463534242u;
+            for (IDType& id: sample) {
+                state = state * 1664525u + 1013904223u;
+                id = parent[(static_cast<size_t>(state) * n) >> 32].load(relaxed);
+            }
+            std::sort(sample.begin(), sample.end());
+            size_t bestRun = 0;
+            for (size_t i = 0, j = 0; i < sample.size(); i = j) {
+                for (j = i; j < sample.size() && sample[j] == sample[i]; ++j) {}
+                if (j - i > bestRun) {
+                    bestRun = j - i;
+                    giant = sample[i];
+                }
+            }
+        }
+
+        pool.parallelFor(0, n, [&](size_t v, size_t) {
+            if (parent[v].load(relaxed) == giant) {
+                return;
+            }
+            auto it = graph[v].vertexBegin();
+            for (size_t k = 0; k < neighbourRounds && it != graph[v].vertexEnd(); ++k) {
+                ++it;
+            }
+            for (; it != graph[v].vertexEnd(); ++it) {
+                link(static_cast<IDType>(v), it->flags.id);
+            }
+        }, 256);
+        compress();
+
+        std::vector<IDType> label(n);
+        pool.parallelFor(0, n, [&parent, &label](size_t v, size_t) { label[v] = parent[v].load(relaxed); });
+        size_t count = denseLabels(label);
+
+        return std::pair(count, std::move(label));
+    }
+
+    // Shiloach-Vishkin connected components: rounds of hooking, where every edge whose
+    // endpoints sit in trees with different labels hangs the larger root under the smaller
+    // label, alternate with pointer jumping until no hook changes anything. Labels are
+    // numbered as in connectedComponents().
+    template <GraphID Graph>
+    requires GraphUndirected<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType>
+    std::pair<size_t, std::vector<typename Graph::IDType>> shiloachVishkin(Graph& graph, ThreadPool& pool) {
+        using IDType = typename Graph::IDType;
+
+        size_t n = graph.vertexCount();
+        constexpr auto relaxed = std::memory_order_relaxed;
+        std::vector<std::atomic<IDType>> parent(n);
+        pool.parallelFor(0, n, [&parent](size_t v, size_t) { parent[v].store(static_cast<IDType>(v), relaxed); });
+
+        std::atomic<bool> changed = true;
+        while (changed.load(relaxed)) {
+            changed.store(false, relaxed);
+            pool.parallelFor(0, n, [&](size_t v, size_t) {
+                for (auto it = graph[v].vertexBegin(); it != graph[v].vertexEnd(); ++it) {
+                    IDType mine = parent[v].load(relaxed);
+                    IDType theirs = parent[it->flags.id].load(relaxed);
+                    // Only a root may be hooked, and another thread may hook it first, so
+                    // the root check and the store must be one step.
+                    IDType expected = theirs;
+                    if (mine < theirs && parent[theirs].compare_exchange_strong(expected, mine, relaxed)) {
+                        changed.store(true, relaxed);
+                    }
+                }
+            }, 256);
+
+            pool.parallelFor(0, n, [&parent](size_t v, size_t) {
+                IDType current = parent[v].load(relaxed);
+                for (IDType up = parent[current].load(relaxed); current != up; up = parent[current].load(relaxed)) {
+                    current = up;
+                }
+                parent[v].store(current, relaxed);
+            });
+        }
+
+        std::vector<IDType> label(n);
+        pool.parallelFor(0, n, [&parent, &label](size_t v, size_t) { label[v] = parent[v].load(relaxed); });
+        size_t count = denseLabels(label);
+
+        return std::pair(count, std::move(label));
+    }
+
+    // A vertex's low value depends on its finished children and on its back edges, so both
+    // are folded in when the vertex is finished. A neighbour is a tree child iff its prev is
+    // the vertex; the root's children are counted as they are discovered.
+    template <VertexAP Vertex, HasPushBack Container>
+    requires std::same_as<Vertex*, typename Container::value_type> &&
+             std::integral<typename Vertex::FlagType::DType>
+    void articulationPoints(Vertex& v, Container& container, typename Vertex::FlagType::DType depth,
+                            DepthFirstStack<Vertex>& stack) {
+        size_t childCount = 0;
+
+        deepFirstTraversal(v, stack, [](Vertex& u) { return u.flags.visited(); }, [](Vertex& u) {
+            u.flags.visit();
+        }, [&v, &childCount, depth](Vertex& u, Vertex* parent) {
+            u.flags.prev = parent;
+            u.flags.dist = parent != nullptr ? parent->flags.dist + 1 : depth;
+            u.flags.low = u.flags.dist;
+            if (parent == &v) {
+                ++childCount;
+            }
+        }, [&v, &container, &childCount](Vertex& u) {
+            bool isArticulation = false;
+            for (auto it = u.vertexBegin(); it != u.vertexEnd(); ++it) {
+                if (it->flags.prev == &u) {
+                    if (it->flags.low >= u.flags.dist) {
+                        isArticulation = true;
+                    }
+                    u.flags.low = u.flags.low < it->flags.low ? u.flags.low : it->flags.low;
+                } else if (&(*it) != u.flags.prev) {
+                    u.flags.low = u.flags.low < it->flags.dist ? u.flags.low : it->flags.dist;
+                }
+            }
+
+            if ((&u != &v && isArticulation) || (&u == &v && childCount > 1)) {
+                container.push_back(&u);
+            }
+        });
+    }
+
+    template <VertexAP Vertex, HasPushBack Container>
+    requires std::same_as<Vertex*, typename Container::value_type> &&
+             std::integral<typename Vertex::FlagType::DType>
+    void articulationPoints(Vertex& v, Container& container, typename Vertex::FlagType::DType depth) {
+        DepthFirstStack<Vertex> stack = {};
+        articulationPoints(v, container, depth, stack);
+    }
+
+    template <GraphAP Graph, HasPushBack Container>
+    requires std::same_as<typename Graph::VertexType*, typename Container::value_type> &&
+             std::integral<typename Graph::VertexType::FlagType::DType>
+    void graphArticulationPoints(Graph& graph, Container& container) {
+        DepthFirstStack<typename Graph::VertexType> stack(graph.vertexCount());
+        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
+            if (!it->flags.visited()) {
+                articulationPoints(*it, container, Graph::VertexType::FlagType::zeroDist(), stack);
+            }
+        }
+
+        graph.reset();
+    }
+
+    // Settles vertices in distance order from start, keeping only the frontier in an indexed
+    // 4-ary heap. The search stops once target is settled or the next distance exceeds bound;
+    // vertices left unvisited by then keep a tentative (or maximal) distance.
+    template <GraphEdge Graph>
+    requires GraphVisit<Graph> &&
+             GraphDist<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             FlagPrev<typename Graph::VertexType::FlagType> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void dijkstra(Graph& graph, typename Graph::VertexType& start, typename Graph::VertexType* target,
+                  typename Graph::VertexType::FlagType::DType bound) {
+        using Vertex = typename Graph::VertexType;
+        using Edge = typename Graph::EdgeType;
+        using DType = typename Vertex::FlagType::DType;
+
+        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
+            it->flags.dist = Vertex::FlagType::maxDist();
+            it->flags.prev = nullptr;
+        }
+
+        IndexedDaryHeap<DType> queue(graph.vertexCount());
+        start.flags.dist = Vertex::FlagType::zeroDist();
+        queue.push(start.flags.id, start.flags.dist);
+
+        while (!queue.empty() && !(bound < queue.topPriority())) {
+            Vertex* vert = &graph[queue.top()];
+            queue.pop();
+            vert->flags.visit();
+            if (vert == target) {
+                break;
+            }
+
+            auto relax = [vert, &queue](Vertex& nv, typename Edge::ValueType::WeightType weight) {
+                if (nv.flags.dist > vert->flags.dist + weight) {
+                    nv.flags.dist = vert->flags.dist + weight;
+                    nv.flags.prev = vert;
+                    queue.pushOrDecrease(nv.flags.id, nv.flags.dist);
+                }
+            };
+            if constexpr (VertexArc<Vertex>) {
+                for (auto arc = vert->arcBegin(); arc != vert->arcEnd(); ++arc) {
+                    relax(graph[arc->target], arc->value.weight());
+                }
+            } else {
+                for (auto neighbour = vert->pairBegin(); neighbour != vert->pairEnd(); ++neighbour) {
+                    relax(*std::get<0>(*neighbour), std::get<1>(*neighbour)->value.weight());
+                }
+            }
+        }
+    }
+
+    template <GraphEdge Graph>
+    requires GraphVisit<Graph> &&
+             GraphDist<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             FlagPrev<typename Graph::VertexType::FlagType> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void dijkstra(Graph& graph, typename Graph::VertexType& start, typename Graph::VertexType& target) {
+        dijkstra(graph, start, &target, Graph::VertexType::FlagType::maxDist());
+    }
+
+    template <GraphEdge Graph>
+    requires GraphVisit<Graph> &&
+             GraphDist<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             FlagPrev<typename Graph::VertexType::FlagType> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void dijkstra(Graph& graph, typename Graph::VertexType& start) {
+        dijkstra(graph, start, nullptr, Graph::VertexType::FlagType::maxDist());
+    }
+
+    template <GraphEdge Graph, IsPropertyMap DistMap, IsPropertyMap PrevMap>
+    requires GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             EdgeWeight<typename Graph::EdgeType> &&
+             std::same_as<typename DistMap::ValueType, typename Graph::EdgeType::ValueType::WeightType> &&
+             std::same_as<typename PrevMap::ValueType, typename Graph::IDType>
+    void dijkstra(Graph& graph, typename Graph::VertexType& start, DistMap& dist, PrevMap& prev,
+                  typename Graph::VertexType* target, typename Graph::EdgeType::ValueType::WeightType bound) {
+        using Vertex = typename Graph::VertexType;
+        using Edge = typename Graph::EdgeType;
+        using Weight = typename Edge::ValueType::WeightType;
+        using IDType = typename Graph::IDType;
+
+        for (size_t i = 0; i < graph.vertexCount(); ++i) {
+            dist[i] = Edge::ValueType::maxWeight();
+            prev[i] = invalidID<IDType>();
+        }
+
+        IndexedDaryHeap<Weight> queue(graph.vertexCount());
+        dist[start.flags.id] = Edge::ValueType::zeroWeight();
+        queue.push(start.flags.id, dist[start.flags.id]);
+
+        while (!queue.empty() && !(bound < queue.topPriority())) {
+            IDType id = static_cast<IDType>(queue.top());
+            queue.pop();
+
+            Vertex& vert = graph[id];
+            if (&vert == target) {
+                break;
+            }
+
+            auto relax = [id, &dist, &prev, &queue](IDType nid, Weight weight) {
+                Weight candidate = dist[id] + weight;
+                if (dist[nid] > candidate) {
+                    dist[nid] = candidate;
+                    prev[nid] = id;
+                    queue.pushOrDecrease(nid, candidate);
+                }
+            };
+            if constexpr (VertexArc<Vertex>) {
+                for (auto arc = vert.arcBegin(); arc != vert.arcEnd(); ++arc) {
+                    relax(static_cast<IDType>(arc->target), arc->value.weight());
+                }
+            } else {
+                for (auto neighbour = vert.pairBegin(); neighbour != vert.pairEnd(); ++neighbour) {
+                    relax(std::get<0>(*neighbour)->flags.id, std::get<1>(*neighbour)->value.weight());
+                }
+            }
+        }
+    }
+
+    template <GraphEdge Graph, IsPropertyMap DistMap, IsPropertyMap PrevMap>
+    requires GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             EdgeWeight<typename Graph::EdgeType> &&
+             std::same_as<typename DistMap::ValueType, typename Graph::EdgeType::ValueType::WeightType> &&
+             std::same_as<typename PrevMap::ValueType, typename Graph::IDType>
+    void dijkstra(Graph& graph, typename Graph::VertexType& start, DistMap& dist, PrevMap& prev) {
+        dijkstra(graph, start, dist, prev, nullptr, Graph::EdgeType::ValueType::maxWeight());
+    }
+
+    // Point-to-point search running dijkstra from source over outgoing edges and from target
+    // over incoming ones, always extending the side with the smaller queue head, until the two
+    // heads add up to at least the best path found so far. backwardCallable(id, relax) has to
+    // call relax(neighbourID, weight) for every edge entering vertex id. Returns the distance
+    // and the vertex IDs on the path, or maxWeight() and an empty path if target is unreachable.
+    template <GraphEdge Graph, typename BackwardCallable>
+    requires GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             EdgeWeight<typename Graph::EdgeType>
+    std::pair<typename Graph::EdgeType::ValueType::WeightType, std::vector<typename Graph::IDType>>
+    bidirectionalSearch(Graph& graph, typename Graph::VertexType& source, typename Graph::VertexType& target,
+                        const BackwardCallable& backwardCallable) {
+        using Vertex = typename Graph::VertexType;
+        using Edge = typename Graph::EdgeType;
+        using Weight = typename Edge::ValueType::WeightType;
+        using IDType = typename Graph::IDType;
+
+        size_t n = graph.vertexCount();
+        IDType sid = source.flags.id;
+        IDType tid = target.flags.id;
+        if (sid == tid) {
+            return std::pair(Edge::ValueType::zeroWeight(), std::vector<IDType>{sid});
+        }
+
+        std::vector<Weight> dist[2] = {std::vector<Weight>(n, Edge::ValueType::maxWeight()),
+                                       std::vector<Weight>(n, Edge::ValueType::maxWeight())};
+        std::vector<IDType> prev[2] = {std::vector<IDType>(n, invalidID<IDType>()),
+                                       std::vector<IDType>(n, invalidID<IDType>())};
+        IndexedDaryHeap<Weight> queue[2] = {IndexedDaryHeap<Weight>(n), IndexedDaryHeap<Weight>(n)};
+        Weight best = Edge::ValueType::maxWeight();
+        IDType meeting = invalidID<IDType>();
+
+        dist[0][sid] = Edge::ValueType::zeroWeight();
+        dist[1][tid] = Edge::ValueType::zeroWeight();
+        queue[0].push(sid, dist[0][sid]);
+        queue[1].push(tid, dist[1][tid]);
+
+        while (!queue[0].empty() && !queue[1].empty()) {
+            if (best != Edge::ValueType::maxWeight() && queue[0].topPriority() + queue[1].topPriority() >= best) {
+                break;
+            }
+
+            size_t side = queue[0].topPriority() <= queue[1].topPriority() ? 0 : 1;
+            IDType id = static_cast<IDType>(queue[side].top());
+            queue[side].pop();
+
+            auto relax = [&dist, &prev, &queue, &best, &meeting, side, id](IDType nid, Weight weight) {
+                Weight candidate = dist[side][id] + weight;
+                if (candidate < dist[side][nid]) {
+                    dist[side][nid] = candidate;
+                    prev[side][nid] = id;
+                    queue[side].pushOrDecrease(nid, candidate);
+                }
+                if (dist[1 - side][nid] != Edge::ValueType::maxWeight() &&
+                    dist[side][nid] + dist[1 - side][nid] < best) {
+                    best = dist[side][nid] + dist[1 - side][nid];
+                    meeting = nid;
+                }
+            };
+
+            if (side == 0) {
+                Vertex& vert = graph[id];
+                for (auto neighbour = vert.pairBegin(); neighbour != vert.pairEnd(); ++neighbour) {
+                    relax(std::get<0>(*neighbour)->flags.id, std::get<1>(*neighbour)->value.weight());
+                }
+            } else {
+                std::invoke(backwardCallable, id, relax);
+            }
+        }
+
+        std::vector<IDType> path = {};
+        if (meeting == invalidID<IDType>()) {
+            return std::pair(best, path);
+        }
+
+        for (IDType id = meeting; id != sid; id = prev[0][id]) {
+            path.push_back(id);
+        }
+        path.push_back(sid);
+        std::reverse(path.begin(), path.end());
+        for (IDType id = meeting; id != tid;) {
+            id = prev[1][id];
+            path.push_back(id);
+        }
+
+        return std::pair(best, path);
+    }
+
+    // Incoming edges are read from reverse, built as WeightedAdjacency(graph, true).
+    template <GraphEdge Graph>
+    requires GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             EdgeWeight<typename Graph::EdgeType>
+    std::pair<typename Graph::EdgeType::ValueType::WeightType, std::vector<typename Graph::IDType>>
+    bidirectionalDijkstra(Graph& graph, typename Graph::VertexType& source, typename Graph::VertexType& target,
+                          const WeightedAdjacency<typename Graph::IDType,
+                                                  typename Graph::EdgeType::ValueType::WeightType>& reverse) {
+        return bidirectionalSearch(graph, source, target, [&reverse](auto id, auto& relax) {
+            for (size_t arc = reverse.begin(id); arc < reverse.end(id); ++arc) {
+                relax(reverse.target(arc), reverse.weight(arc));
+            }
+        });
+    }
+
+    template <GraphEdge Graph>
+    requires GraphUndirected<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             EdgeWeight<typename Graph::EdgeType>
+    std::pair<typename Graph::EdgeType::ValueType::WeightType, std::vector<typename Graph::IDType>>
+    bidirectionalDijkstra(Graph& graph, typename Graph::VertexType& source, typename Graph::VertexType& target) {
+        return bidirectionalSearch(graph, source, target, [&graph](auto id, auto& relax) {
+            auto& vert = graph[id];
+            for (auto neighbour = vert.pairBegin(); neighbour != vert.pairEnd(); ++neighbour) {
+                relax(std::get<0>(*neighbour)->flags.id, std::get<1>(*neighbour)->value.weight());
+            }
+        });
+    }
+
+    // dijkstra() ordered by dist + heuristic(vertex), stopping once target is settled. The
+    // heuristic has to be consistent: it never overestimates and drops by at most the edge
+    // weight along any edge, e.g. straight-line distance when weights are lengths. A heuristic
+    // value of maxDist() marks a vertex that provably cannot reach target; it is never queued,
+    // so when start is such a vertex nothing is searched. Like dijkstra(), relaxation only
+    // compares distances, so visited flags left by an earlier search need no reset().
+    template <GraphEdge Graph, typename Heuristic>
+    requires GraphVisit<Graph> &&
+             GraphDist<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             FlagPrev<typename Graph::VertexType::FlagType> &&
+             EdgeWeight<typename Graph::EdgeType> &&
+             std::invocable<Heuristic, typename Graph::VertexType&> &&
+             std::convertible_to<std::invoke_result_t<Heuristic, typename Graph::VertexType&>,
+                                 typename Graph::VertexType::FlagType::DType>
+    void aStar(Graph& graph, typename Graph::VertexType& start, typename Graph::VertexType& target,
+               const Heuristic& heuristic) {
+        using Vertex = typename Graph::VertexType;
+        using Edge = typename Graph::EdgeType;
+        using DType = typename Vertex::FlagType::DType;
+
+        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
+            it->flags.dist = Vertex::FlagType::maxDist();
+            it->flags.prev = nullptr;
+        }
+
+        IndexedDaryHeap<DType> queue(graph.vertexCount());
+        start.flags.dist = Vertex::FlagType::zeroDist();
+        DType startEstimate = static_cast<DType>(std::invoke(heuristic, start));
+        if (startEstimate != Vertex::FlagType::maxDist()) {
+            queue.push(start.flags.id, startEstimate);
+        }
+
+        while (!queue.empty()) {
+            Vertex* vert = &graph[queue.top()];
+            queue.pop();
+            vert->flags.visit();
+            if (vert == &target) {
+                break;
+            }
+
+            for (auto neighbour = vert->pairBegin(); neighbour != vert->pairEnd(); ++neighbour) {
+                Vertex& nv = *std::get<0>(*neighbour);
+                Edge& ne = *std::get<1>(*neighbour);
+                if (nv.flags.dist > vert->flags.dist + ne.value.weight()) {
+                    DType estimate = static_cast<DType>(std::invoke(heuristic, nv));
+                    if (estimate == Vertex::FlagType::maxDist()) {
+                        continue;
+                    }
+                    nv.flags.dist = vert->flags.dist + ne.value.weight();
+                    nv.flags.prev = vert;
+                    queue.pushOrDecrease(nv.flags.id, nv.flags.dist + estimate);
+                }
+            }
+        }
+    }
+
+    template <std::integral IDType, typename Weight>
+    void dijkstra(const WeightedAdjacency<IDType, Weight>& adjacency, size_t source, std::vector<Weight>& dist) {
+        dist.assign(adjacency.vertexCount(), std::numeric_limits<Weight>::max());
+
+        IndexedDaryHeap<Weight> queue(adjacency.vertexCount());
+        dist[source] = Weight{0};
+        queue.push(source, dist[source]);
+
+        while (!queue.empty()) {
+            size_t id = queue.top();
+            queue.pop();
+            for (size_t arc = adjacency.begin(id); arc < adjacency.end(id); ++arc) {
+                size_t nid = adjacency.target(arc);
+                Weight candidate = dist[id] + adjacency.weight(arc);
+                if (candidate < dist[nid]) {
+                    dist[nid] = candidate;
+                    queue.pushOrDecrease(nid, candidate);
+                }
+            }
+        }
+    }
+
+    // Picks up to landmarkCount landmarks by the farthest-point heuristic: the first one is the
+    // vertex farthest from vertex 0, every next one the vertex farthest from all landmarks so
+    // far, preferring vertices none of them reaches.
+    template <GraphEdge Graph>
+    requires GraphID<Graph> &&
+             EdgeWeight<typename Graph::EdgeType>
+    LandmarkTable<typename Graph::EdgeType::ValueType::WeightType>
+    landmarkTable(Graph& graph, size_t landmarkCount) {
+        using Weight = typename Graph::EdgeType::ValueType::WeightType;
+        using IDType = typename Graph::IDType;
+
+        size_t n = graph.vertexCount();
+        Weight infinity = std::numeric_limits<Weight>::max();
+        LandmarkTable<Weight> table(n, Graph::DIRECTED);
+        if (n == 0) {
+            return table;
+        }
+
+        WeightedAdjacency<IDType, Weight> forward(graph, false);
+        WeightedAdjacency<IDType, Weight> backward = {};
+        if constexpr (Graph::DIRECTED) {
+            backward = WeightedAdjacency<IDType, Weight>(graph, true);
+        }
+
+        std::vector<Weight> distFrom = {};
+        std::vector<Weight> distTo = {};
+        std::vector<Weight> nearest(n, infinity);
+
+        dijkstra(forward, 0, distFrom);
+        size_t landmark = 0;
+        for (size_t v = 0; v < n; ++v) {
+            if (distFrom[v] != infinity && distFrom[v] > distFrom[landmark]) {
+                landmark = v;
+            }
+        }
+
+        for (size_t l = 0; l < landmarkCount && l < n; ++l) {
+            dijkstra(forward, landmark, distFrom);
+            if constexpr (Graph::DIRECTED) {
+                dijkstra(backward, landmark, distTo);
+            }
+            table.addLandmark(landmark, distFrom, distTo);
+
+            for (size_t v = 0; v < n; ++v) {
+                nearest[v] = std::min(nearest[v], Graph::DIRECTED ? std::min(distFrom[v], distTo[v]) : distFrom[v]);
+            }
+
+            landmark = 0;
+            for (size_t v = 0; v < n; ++v) {
+                if (nearest[landmark] != infinity && (nearest[v] == infinity || nearest[v] > nearest[landmark])) {
+                    landmark = v;
+                }
+            }
+            if (nearest[landmark] == Weight{0}) {
+                break;
+            }
+        }
+
+        return table;
+    }
+
+    // A* guided by the landmark lower bounds (ALT); the table must come from the same graph.
+    // Vertices the table proves unable to reach target are never queued.
+    template <GraphEdge Graph>
+    requires GraphVisit<Graph> &&
+             GraphDist<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             FlagPrev<typename Graph::VertexType::FlagType> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void landmarkSearch(Graph& graph, const LandmarkTable<typename Graph::EdgeType::ValueType::WeightType>& table,
+                        typename Graph::VertexType& start, typename Graph::VertexType& target) {
+        using Vertex = typename Graph::VertexType;
+        using DType = typename Vertex::FlagType::DType;
+
+        using Weight = typename Graph::EdgeType::ValueType::WeightType;
+
+        size_t tid = target.flags.id;
+        aStar(graph, start, target, [&table, tid](Vertex& v) {
+            Weight bound = table.lowerBound(v.flags.id, tid);
+            return bound == std::numeric_limits<Weight>::max() ? Vertex::FlagType::maxDist() : static_cast<DType>(bound);
+        });
+    }
+
+    // Contracts vertices in order of twice the edge difference (shortcuts added minus arcs
+    // removed) plus the number of contracted neighbours, re-evaluated lazily when a vertex
+    // reaches the queue head.
+    // A shortcut u -> x is added only if a local witness search from u that avoids the
+    // contracted vertex finds no path as short; the search gives up after witnessLimit settled
+    // vertices, which can only cost extra shortcuts. Edge weights must not be negative.
+    template <GraphEdge Graph>
+    requires GraphID<Graph> &&
+             EdgeWeight<typename Graph::EdgeType> &&
+             std::integral<typename Graph::IDType>
+    ContractionHierarchy<typename Graph::IDType, typename Graph::EdgeType::ValueType::WeightType>
+    contractionHierarchy(Graph& graph, size_t witnessLimit = 1000) {
+        using Weight = typename Graph::EdgeType::ValueType::WeightType;
+        using IDType = typename Graph::IDType;
+        using Hierarchy = ContractionHierarchy<IDType, Weight>;
+        using Arc = typename Hierarchy::ArcType;
+
+        size_t n = graph.vertexCount();
+        Weight infinity = std::numeric_limits<Weight>::max();
+        std::vector<std::vector<Arc>> out(n);
+        std::vector<std::vector<Arc>> in(n);
+
+        auto addArc = [&out, &in](IDType from, IDType to, Weight weight, IDType middle) {
+            for (Arc& arc: out[from]) {
+                if (std::get<0>(arc) == to) {
+                    if (weight < std::get<1>(arc)) {
+                        arc = Arc(to, weight, middle);
+                        for (Arc& reverse: in[to]) {
+                            if (std::get<0>(reverse) == from) {
+                                reverse = Arc(from, weight, middle);
+                            }
+                        }
+                    }
+                    return;
+                }
+            }
+            out[from].emplace_back(to, weight, middle);
+            in[to].emplace_back(from, weight, middle);
+        };
+
+        for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+            if (it->from() != it->to()) {
+                addArc(it->from(), it->to(), it->value.weight(), invalidID<IDType>());
+                if constexpr (!Graph::DIRECTED) {
+                    addArc(it->to(), it->from(), it->value.weight(), invalidID<IDType>());
+                }
+            }
+        }
+
+        std::vector<bool> contracted(n, false);
+        std::vector<size_t> contractedNeighbours(n, 0);
+        std::vector<Weight> witnessDist(n, infinity);
+        std::vector<IDType> touched = {};
+        IndexedDaryHeap<Weight> witnessQueue(n);
+
+        auto witness = [&](IDType source, IDType skipped, Weight limit) {
+            for (IDType id: touched) {
+                witnessDist[id] = infinity;
+            }
+            touched.clear();
+            witnessQueue.clear();
+
+            witnessDist[source] = Weight{0};
+            touched.push_back(source);
+            witnessQueue.push(source, witnessDist[source]);
+
+            for (size_t settled = 0; !witnessQueue.empty() && witnessQueue.topPriority() <= limit &&
+                                     settled < witnessLimit; ++settled) {
+                IDType id = static_cast<IDType>(witnessQueue.top());
+                witnessQueue.pop();
+                for (Arc& arc: out[id]) {
+                    IDType next = std::get<0>(arc);
+                    Weight candidate = witnessDist[id] + std::get<1>(arc);
+                    if (contracted[next] || next == skipped || !(candidate < witnessDist[next])) {
+                        continue;
+                    }
+                    if (witnessDist[next] == infinity) {
+                        touched.push_back(next);
+                    }
+                    witnessDist[next] = candidate;
+                    witnessQueue.pushOrDecrease(next, candidate);
+                }
+            }
+        };
+
+        // Counts the shortcuts contracting v needs and, if apply is set, inserts them.
+        auto contract = [&](IDType v, bool apply) {
+            size_t shortcuts = 0;
+            for (size_t i = 0; i < in[v].size(); ++i) {
+                auto [u, inWeight, inMiddle] = in[v][i];
+                if (contracted[u]) {
+                    continue;
+                }
+
+                Weight limit = Weight{0};
+                for (Arc& arc: out[v]) {
+                    if (!contracted[std::get<0>(arc)] && std::get<0>(arc) != u) {
+                        limit = std::max(limit, inWeight + std::get<1>(arc));
+                    }
+                }
+                witness(u, v, limit);
+
+                for (size_t j = 0; j < out[v].size(); ++j) {
+                    auto [x, outWeight, outMiddle] = out[v][j];
+                    if (contracted[x] || x == u || witnessDist[x] <= inWeight + outWeight) {
+                        continue;
+                    }
+                    ++shortcuts;
+                    if (apply) {
+                        addArc(u, x, inWeight + outWeight, v);
+                    }
+                }
+            }
+            return shortcuts;
+        };
+
+        auto priority = [&](IDType v) {
+            long long removed = 0;
+            for (Arc& arc: in[v]) {
+                removed += contracted[std::get<0>(arc)] ? 0 : 1;
+            }
+            for (Arc& arc: out[v]) {
+                removed += contracted[std::get<0>(arc)] ? 0 : 1;
+            }
+            long long shortcuts = static_cast<long long>(contract(v, false));
+            return 2 * (shortcuts - removed) + static_cast<long long>(contractedNeighbours[v]);
+        };
+
+        IndexedDaryHeap<long long> order(n);
+        for (size_t v = 0; v < n; ++v) {
+            order.push(v, priority(static_cast<IDType>(v)));
+        }
+
+        std::vector<size_t> rank(n, 0);
+        size_t nextRank = 0;
+        while (!order.empty()) {
+            IDType v = static_cast<IDType>(order.top());
+            order.pop();
+            long long current = priority(v);
+            if (!order.empty() && current > order.topPriority()) {
+                order.push(v, current);
+                continue;
+            }
+
+            contract(v, true);
+            contracted[v] = true;
+            rank[v] = nextRank++;
+            for (Arc& arc: in[v]) {
+                ++contractedNeighbours[std::get<0>(arc)];
+            }
+            for (Arc& arc: out[v]) {
+                ++contractedNeighbours[std::get<0>(arc)];
+            }
+        }
+
+        std::vector<std::vector<Arc>> up(n);
+        std::vector<std::vector<Arc>> down(n);
+        for (size_t v = 0; v < n; ++v) {
+            for (Arc& arc: out[v]) {
+                if (rank[std::get<0>(arc)] > rank[v]) {
+                    up[v].push_back(arc);
+                }
+            }
+            for (Arc& arc: in[v]) {
+                if (rank[std::get<0>(arc)] > rank[v]) {
+                    down[v].push_back(arc);
+                }
+            }
+        }
+
+        return Hierarchy(std::move(rank), up, down);
+    }
+
+    // Parallel single-source shortest paths with the same results as dijkstra(). Tentative
+    // distances are kept in buckets of width delta; the lowest bucket is emptied by repeatedly
+    // relaxing light edges (weight <= delta) and then relaxing the heavy edges of the vertices
+    // it settled. Every vertex is owned by thread id % threadCount, which alone writes its
+    // flags and buckets; other threads send it relaxation requests through per-thread buffers.
+    // Pending distances never lie more than the heaviest edge beyond the current bucket, so the
+    // buckets form a ring of maxWeight / delta + 2 slots. Edge weights must not be negative;
+    // delta must be positive and is replaced by 1 otherwise.
+    template <GraphEdge Graph>
+    requires GraphVisit<Graph> &&
+             GraphDist<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             FlagPrev<typename Graph::VertexType::FlagType> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void deltaStepping(Graph& graph, typename Graph::VertexType& start,
+                       typename Graph::VertexType::FlagType::DType delta, ThreadPool& pool) {
+        using Vertex = typename Graph::VertexType;
+        using DType = typename Vertex::FlagType::DType;
+        using IDType = typename Graph::IDType;
+        using Request = std::tuple<IDType, DType, IDType>;
+
+        constexpr size_t NO_BUCKET = std::numeric_limits<size_t>::max();
+        size_t threads = pool.threadCount();
+        size_t n = graph.vertexCount();
+        if (!(delta > DType{0})) {
+            delta = DType{1};
+        }
+
+        DType maxWeight = Vertex::FlagType::zeroDist();
+        for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+            maxWeight = std::max(maxWeight, static_cast<DType>(it->value.weight()));
+        }
+        // The spare slot absorbs rounding when distances are floating point.
+        size_t slots = static_cast<size_t>(maxWeight / delta) + 2;
+        auto bucketOf = [delta](DType dist) { return static_cast<size_t>(dist / delta); };
+
+        pool.parallelFor(0, n, [&graph](size_t i, size_t) {
+            graph[i].flags.dist = Vertex::FlagType::maxDist();
+            graph[i].flags.prev = nullptr;
+        });
+
+        std::vector<std::vector<std::vector<IDType>>> buckets(threads, std::vector<std::vector<IDType>>(slots));
+        std::vector<std::vector<IDType>> settled(threads);
+        std::vector<std::vector<Request>> requests(threads * threads);
+        std::vector<DType> lightDist(n, Vertex::FlagType::maxDist());
+        std::vector<DType> heavyDist(n, Vertex::FlagType::maxDist());
+
+        auto owner = [threads](size_t id) { return id % threads; };
+
+        auto insert = [&graph, &buckets, &bucketOf, slots](size_t thread, IDType id) {
+            buckets[thread][bucketOf(graph[id].flags.dist) % slots].push_back(id);
+        };
+
+        auto relax = [&graph, &requests, &owner, threads, delta](size_t thread, IDType id, bool light) {
+            Vertex& vert = graph[id];
+            for (auto neighbour = vert.pairBegin(); neighbour != vert.pairEnd(); ++neighbour) {
+                DType weight = static_cast<DType>(std::get<1>(*neighbour)->value.weight());
+                if ((weight <= delta) == light) {
+                    IDType nid = std::get<0>(*neighbour)->flags.id;
+                    requests[thread * threads + owner(nid)].emplace_back(nid, vert.flags.dist + weight, id);
+                }
+            }
+        };
+
+        auto apply = [&graph, &requests, &insert, threads](size_t thread) {
+            for (size_t from = 0; from < threads; ++from) {
+                for (Request& request: requests[from * threads + thread]) {
+                    Vertex& target = graph[std::get<0>(request)];
+                    if (std::get<1>(request) < target.flags.dist) {
+                        target.flags.dist = std::get<1>(request);
+                        target.flags.prev = &graph[std::get<2>(request)];
+                        insert(thread, std::get<0>(request));
+                    }
+                }
+                requests[from * threads + thread].clear();
+            }
+        };
+
+        // Looks at most one turn of the ring ahead of first.
+        auto nextBucket = [&buckets, slots](size_t first) {
+            for (size_t bucket = first; bucket < first + slots; ++bucket) {
+                for (auto& own: buckets) {
+                    if (!own[bucket % slots].empty()) {
+                        return bucket;
+                    }
+                }
+            }
+            return NO_BUCKET;
+        };
+
+        start.flags.dist = Vertex::FlagType::zeroDist();
+        insert(owner(start.flags.id), start.flags.id);
+
+        for (size_t bucket = nextBucket(0); bucket != NO_BUCKET; bucket = nextBucket(bucket + 1)) {
+            while (nextBucket(bucket) == bucket) {
+                pool.runOnEachThread([&](size_t thread) {
+                    std::vector<IDType> current = {};
+                    std::swap(current, buckets[thread][bucket % slots]);
+                    for (IDType id: current) {
+                        DType dist = graph[id].flags.dist;
+                        if (bucketOf(dist) != bucket || lightDist[id] == dist) {
+                            continue;
+                        }
+                        lightDist[id] = dist;
+                        settled[thread].push_back(id);
+                        relax(thread, id, true);
+                    }
+                });
+                pool.runOnEachThread(apply);
+            }
+
+            pool.runOnEachThread([&](size_t thread) {
+                for (IDType id: settled[thread]) {
+                    if (heavyDist[id] != graph[id].flags.dist) {
+                        heavyDist[id] = graph[id].flags.dist;
+                        relax(thread, id, false);
+                    }
+                }
+                settled[thread].clear();
+            });
+            pool.runOnEachThread(apply);
+        }
+
+        pool.parallelFor(0, n, [&graph](size_t i, size_t) {
+            if (graph[i].flags.dist != Vertex::FlagType::maxDist()) {
+                graph[i].flags.visit();
+            }
+        });
+    }
+
+    template <GraphEdge Graph, HasPushBack Container>
+    requires std::same_as<typename Graph::EdgeType*, typename Container::value_type> &&
+             GraphVisit<Graph> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void prim(Graph& graph, Container& container) {
+        using Vertex = typename Graph::VertexType;
+        using Edge = typename Graph::EdgeType;
+        using Pair = typename Vertex::PairType;
+
+        Vertex& v1 = *graph.vertexBegin();
+        v1.flags.visit();
+
+        // Pairs are queued by value so that vertices building them on the fly work too.
+        auto queue = std::priority_queue([](const Pair& a, const Pair& b) {
+            return std::get<1>(a)->value.weight() > std::get<1>(b)->value.weight();
+        }, std::vector<Pair>());
+
+        for (auto it = v1.pairBegin(); it != v1.pairEnd(); ++it) {
+            queue.push(*it);
+        }
+
+        while (!queue.empty()) {
+            Pair pair = queue.top();
+            Vertex* vert = std::get<0>(pair);
+            Edge* edge = std::get<1>(pair);
+            queue.pop();
+
+            if (!vert->flags.visited()) {
+                vert->flags.visit();
+                container.push_back(edge);
+                for (auto it = vert->pairBegin(); it != vert->pairEnd(); ++it) {
+                    if (!std::get<0>(*it)->flags.visited()) {
+                        queue.push(*it);
+                    }
+                }
+            }
+        }
+    }
+
+    // Stable sort on the pool: every thread sorts one slice, then neighbouring runs are merged
+    // pairwise in parallel until a single run is left.
+    template <typename Value, typename Compare>
+    void parallelStableSort(std::vector<Value>& values, const Compare& compare, ThreadPool& pool) {
+        size_t runs = std::min(pool.threadCount(), std::max<size_t>(values.size() / 1024, 1));
+        std::vector<size_t> bounds(runs + 1);
+        for (size_t run = 0; run <= runs; ++run) {
+            bounds[run] = values.size() * run / runs;
+        }
+
+        pool.parallelFor(0, runs, [&values, &compare, &bounds](size_t run, size_t) {
+            std::stable_sort(values.begin() + bounds[run], values.begin() + bounds[run + 1], compare);
+        }, 1);
+
+        for (size_t width = 1; width < runs; width *= 2) {
+            pool.parallelFor(0, (runs + 2 * width - 1) / (2 * width), [&](size_t pair, size_t) {
+                size_t first = pair * 2 * width;
+                size_t middle = std::min(first + width, runs);
+                size_t last = std::min(first + 2 * width, runs);
+                std::inplace_merge(values.begin() + bounds[first], values.begin() + bounds[middle],
+                                   values.begin() + bounds[last], compare);
+            }, 1);
+        }
+    }
+
+    // Kruskal's minimum spanning forest: edges are sorted by weight (on the pool, if one is
+    // given) and taken whenever a path-compressed union-find shows they join two trees. The
+    // forest covers every component; its edges are pushed in order of weight.
+    template <GraphEdge Graph, HasPushBack Container>
+    requires std::same_as<typename Graph::EdgeType*, typename Container::value_type> &&
+             GraphUndirected<Graph> &&
+             GraphID<Graph> &&
+             std::integral<typename Graph::IDType> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void kruskal(Graph& graph, Container& container, ThreadPool* pool = nullptr) {
+        using Edge = typename Graph::EdgeType;
+        using IDType = typename Graph::IDType;
+
+        std::vector<Edge*> edges = {};
+        for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+            if (it->from() != it->to()) {
+                edges.push_back(&(*it));
+            }
+        }
+
+        auto lighter = [](Edge* a, Edge* b) { return a->value.weight() < b->value.weight(); };
+        if (pool != nullptr) {
+            parallelStableSort(edges, lighter, *pool);
+        } else {
+            std::stable_sort(edges.begin(), edges.end(), lighter);
+        }
+
+        DisjointSets<IDType> trees(graph.vertexCount());
+        for (Edge* edge: edges) {
+            if (trees.unite(edge->from(), edge->to())) {
+                container.push_back(edge);
+                if (trees.setCount() == 1) {
+                    break;
+                }
+            }
+        }
+    }
+
+    // Parallel Boruvka minimum spanning forest. Each round the threads scan their own slices
+    // of the remaining edges, drop those inside one tree and keep, for every tree, its lightest
+    // outgoing edge in an atomic slot; ties are broken by edge index, so the chosen edges never
+    // close a cycle. The chosen edges are then merged sequentially, which takes at most one
+    // step per tree. Rounds at least halve the number of trees, and the forest covers every
+    // component.
+    template <GraphEdge Graph, HasPushBack Container>
+    requires std::same_as<typename Graph::EdgeType*, typename Container::value_type> &&
+             GraphUndirected<Graph> &&
+             GraphID<Graph> &&
+             std::integral<typename Graph::IDType> &&
+             EdgeWeight<typename Graph::EdgeType>
+    void boruvka(Graph& graph, Container& container, ThreadPool& pool) {
+        using Edge = typename Graph::EdgeType;
+        using IDType = typename Graph::IDType;
+
+        constexpr size_t NO_EDGE = std::numeric_limits<size_t>::max();
+        size_t n = graph.vertexCount();
+        size_t threads = pool.threadCount();
+
+        std::vector<Edge*> edges = {};
+        for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+            if (it->from() != it->to()) {
+                edges.push_back(&(*it));
+            }
+        }
+
+        // Each thread owns the slice [begin, begin + count) of the remaining edge indices.
+        std::vector<size_t> remaining(edges.size());
+        std::vector<size_t> sliceBegin(threads);
+        std::vector<size_t> sliceCount(threads);
+        for (size_t thread = 0; thread < threads; ++thread) {
+            sliceBegin[thread] = edges.size() * thread / threads;
+            sliceCount[thread] = edges.size() * (thread + 1) / threads - sliceBegin[thread];
+        }
+        for (size_t e = 0; e < edges.size(); ++e) {
+            remaining[e] = e;
+        }
+
+        auto lighter = [&edges](size_t a, size_t b) {
+            auto wa = edges[a]->value.weight();
+            auto wb = edges[b]->value.weight();
+            return wa < wb || (!(wb < wa) && a < b);
+        };
+
+        DisjointSets<IDType> trees(n);
+        std::vector<IDType> label(n);
+        std::vector<std::atomic<size_t>> cheapest(n);
+        std::vector<IDType> roots(n);
+        for (size_t v = 0; v < n; ++v) {
+            roots[v] = static_cast<IDType>(v);
+            cheapest[v].store(NO_EDGE, std::memory_order_relaxed);
+        }
+
+        while (roots.size() > 1) {
+            pool.parallelFor(0, n, [&trees, &label](size_t v, size_t) {
+                label[v] = trees.representative(static_cast<IDType>(v));
+            });
+
+            pool.runOnEachThread([&](size_t thread) {
+                size_t* slice = remaining.data() + sliceBegin[thread];
+                size_t kept = 0;
+                for (size_t i = 0; i < sliceCount[thread]; ++i) {
+                    size_t e = slice[i];
+                    IDType a = label[edges[e]->from()];
+                    IDType b = label[edges[e]->to()];
+                    if (a == b) {
+                        continue;
+                    }
+                    slice[kept++] = e;
+                    for (IDType tree: {a, b}) {
+                        size_t current = cheapest[tree].load(std::memory_order_relaxed);
+                        while ((current == NO_EDGE || lighter(e, current)) &&
+                               !cheapest[tree].compare_exchange_weak(current, e, std::memory_order_relaxed)) {}
+                    }
+                }
+                sliceCount[thread] = kept;
+            });
+
+            bool merged = false;
+            for (IDType root: roots) {
+                size_t e = cheapest[root].exchange(NO_EDGE, std::memory_order_relaxed);
+                if (e != NO_EDGE && trees.unite(edges[e]->from(), edges[e]->to())) {
+                    container.push_back(edges[e]);
+                    merged = true;
+                }
+            }
+            if (!merged) {
+                break;
+            }
+
+            std::erase_if(roots, [&trees](IDType root) { return trees.find(root) != root; });
+        }
+    }
+
+    template <typename Weight, IsVertex Vertex, typename IDType>
+    void setMatrixPair(std::vector<std::vector<std::pair<Weight, Vertex*>>>& matrix, IDType from, IDType to,
+                       Weight weight, Vertex* vertex) {
+        std::get<0>(matrix[from][to]) = weight;
+        std::get<1>(matrix[from][to]) = vertex;
+    }
+
+    template <GraphEdge Graph>
+    requires GraphID<Graph> &&
+             GraphDirected<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             EdgeWeight<typename Graph::EdgeType>
+    std::vector<std::vector<std::pair<typename Graph::EdgeType::ValueType::WeightType, typename Graph::VertexType*>>>
+    floydWarshall(Graph& graph) {
+        using Vertex = typename Graph::VertexType;
+        using Edge   = typename Graph::EdgeType;
+        using Weight = typename Graph::EdgeType::ValueType::WeightType;
+
+        std::vector<std::vector<std::pair<Weight, Vertex*>>> matrix =
+                {graph.vertexCount(), {graph.vertexCount(), {Edge::ValueType::maxWeight(), nullptr}}};
+
+        for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+            setMatrixPair(matrix, it->from(), it->to(), it->value.weight(), &graph[it->from()]);
+        }
+
+        for (auto it = graph.vertexBegin(); it != graph.vertexEnd(); ++it) {
+            setMatrixPair(matrix, it->flags.id, it->flags.id, Edge::ValueType::zeroWeight(), &(*it));
+        }
+
+        for (size_t k = 0; k < graph.vertexCount(); ++k) {
+            for (size_t i = 0; i < graph.vertexCount(); ++i) {
+                for (size_t j = 0; j < graph.vertexCount(); ++j) {
+                    Weight detour;
+                    if (std::get<0>(matrix[i][k]) == Edge::ValueType::maxWeight() ||
+                        std::get<0>(matrix[k][j]) == Edge::ValueType::maxWeight()) {
+                        detour = Edge::ValueType::maxWeight();
+                    } else {
+                        detour = std::get<0>(matrix[i][k]) + std::get<0>(matrix[k][j]);
+                    }
+                    if (std::get<0>(matrix[i][j]) > detour) {
+                        setMatrixPair(matrix, i, j, detour, std::get<1>(matrix[k][j]));
+                    }
+                }
+            }
+        }
+
+        return matrix;
+    }
+
+    // Relaxes row[j] through a pivot for j < width. None of the spans may overlap. The body
+    // is select-only and the main loop runs fixed-width chunks, which lets it vectorize at
+    // -O2, where GCC only vectorizes loops whose trip count needs no scalar epilogue.
+    template <typename Weight>
+    void relaxDistanceRow(Weight* SGL_RESTRICT row, std::uint32_t* SGL_RESTRICT nextRow,
+                          const Weight* SGL_RESTRICT pivotRow, size_t width, Weight ik, std::uint32_t nextIK) {
+        constexpr size_t LANES = 16;
+        const Weight infinity = DistanceMatrix<Weight>::infinity();
+        size_t j = 0;
+        for (; j + LANES <= width; j += LANES) {
+            for (size_t lane = j; lane < j + LANES; ++lane) {
+                Weight kj = pivotRow[lane];
+                Weight sum = ik + kj;
+                Weight current = row[lane];
+                bool shorter = (kj < infinity) & (sum < current);
+                row[lane] = shorter ? sum : current;
+                nextRow[lane] = shorter ? nextIK : nextRow[lane];
+            }
+        }
+        for (; j < width; ++j) {
+            Weight kj = pivotRow[j];
+            Weight sum = ik + kj;
+            Weight current = row[j];
+            bool shorter = (kj < infinity) & (sum < current);
+            row[j] = shorter ? sum : current;
+            nextRow[j] = shorter ? nextIK : nextRow[j];
+        }
+    }
+
+    // Relaxes tile (rows, columns) through the vertices of tile column pivots. Rows whose
+    // distance to the pivot is infinite are skipped; paths through a missing pivot edge stay
+    // at infinity so negative weights cannot pull them below it. The pivot row can be one of
+    // the relaxed rows, so it is copied into pivotRow, which must hold the tile's width, to
+    // keep the spans passed to relaxDistanceRow disjoint.
+    template <typename Weight>
+    void relaxDistanceTile(DistanceMatrix<Weight>& matrix, size_t rowBegin, size_t rowEnd, size_t columnBegin,
+                           size_t columnEnd, size_t pivotBegin, size_t pivotEnd, Weight* pivotRow) {
+        const Weight infinity = DistanceMatrix<Weight>::infinity();
+        size_t n = matrix.size();
+        size_t width = columnEnd - columnBegin;
+        Weight* dist = matrix.distanceData();
+        std::uint32_t* next = matrix.nextData();
+
+        for (size_t k = pivotBegin; k < pivotEnd; ++k) {
+            std::copy_n(dist + k * n + columnBegin, width, pivotRow);
+            for (size_t i = rowBegin; i < rowEnd; ++i) {
+                Weight ik = dist[i * n + k];
+                if (!(ik < infinity)) {
+                    continue;
+                }
+                relaxDistanceRow(dist + i * n + columnBegin, next + i * n + columnBegin, pivotRow, width,
+                                 ik, next[i * n + k]);
+            }
+        }
+    }
+
+    // Floyd-Warshall in three phases per block of pivots: the diagonal tile, then the tiles
+    // sharing its row or column, then all remaining tiles. Tiles within the second and third
+    // phase are independent and run on pool when one is given, each thread copying pivot
+    // rows into its own slice of one scratch buffer. Negative edges are allowed, negative
+    // cycles are not.
+    template <GraphEdge Graph>
+    requires GraphID<Graph> &&
+             EdgeWeight<typename Graph::EdgeType>
+    DistanceMatrix<typename Graph::EdgeType::ValueType::WeightType>
+    floydWarshallMatrix(Graph& graph, ThreadPool* pool = nullptr, size_t blockSize = 64) {
+        using Weight = typename Graph::EdgeType::ValueType::WeightType;
+
+        size_t n = graph.vertexCount();
+        DistanceMatrix<Weight> matrix(n);
+        for (auto it = graph.edgeBegin(); it != graph.edgeEnd(); ++it) {
+            size_t from = it->from();
+            size_t to = it->to();
+            Weight weight = it->value.weight();
+            if (weight < matrix.distance(from, to)) {
+                matrix.distance(from, to) = weight;
+                matrix.next(from, to) = static_cast<std::uint32_t>(to);
+            }
+            if (!Graph::DIRECTED && weight < matrix.distance(to, from)) {
+                matrix.distance(to, from) = weight;
+                matrix.next(to, from) = static_cast<std::uint32_t>(from);
+            }
+        }
+
+        blockSize = std::max<size_t>(std::min(blockSize, n), 1);
+        size_t blocks = (n + blockSize - 1) / blockSize;
+        std::vector<Weight> pivotRows((pool != nullptr ? pool->threadCount() : 1) * blockSize);
+        auto relax = [&matrix, &pivotRows, n, blockSize](size_t rows, size_t columns, size_t pivots, size_t thread) {
+            relaxDistanceTile(matrix, rows * blockSize, std::min(n, (rows + 1) * blockSize),
+                              columns * blockSize, std::min(n, (columns + 1) * blockSize),
+                              pivots * blockSize, std::min(n, (pivots + 1) * blockSize),
+                              pivotRows.data() + thread * blockSize);
+        };
+        auto forEach = [pool](size_t count, const auto& callable) {
+            if (pool != nullptr) {
+                pool->parallelFor(0, count, callable, 1);
+            } else {
+                for (size_t index = 0; index < count; ++index) {
+                    callable(index, 0);
+                }
+            }
+        };
+
+        for (size_t k = 0; k < blocks; ++k) {
+            relax(k, k, k, 0);
+            forEach(2 * blocks, [&relax, k, blocks](size_t index, size_t thread) {
+                size_t other = index % blocks;
+                if (other == k) {
+                    return;
+                }
+                if (index < blocks) {
+                    relax(k, other, k, thread);
+                } else {
+                    relax(other, k, k, thread);
+                }
+            });
+            forEach(blocks * blocks, [&relax, k, blocks](size_t index, size_t thread) {
+                size_t rows = index / blocks;
+                size_t columns = index % blocks;
+                if (rows != k && columns != k) {
+                    relax(rows, columns, k, thread);
+                }
+            });
+        }
+
+        return matrix;
+    }
+
+    // Sparse all-pairs shortest paths: Bellman-Ford potentials from a virtual source make every
+    // edge weight non-negative, then one Dijkstra per source runs on pool. rowCallable(source,
+    // dist) receives each row as soon as it is done, with maxWeight() for unreachable vertices;
+    // it is called concurrently from the pool's threads, once per source, and dist is only
+    // valid during the call. Returns false, without calling rowCallable, if the graph has a
+    // negative cycle.
+    template <GraphEdge Graph, typename RowCallable>
+    requires GraphID<Graph> &&
+             EdgeWeight<typename Graph::EdgeType> &&
+             std::invocable<RowCallable, size_t, const std::vector<typename Graph::EdgeType::ValueType::WeightType>&>
+    bool johnson(Graph& graph, ThreadPool& pool, const RowCallable& rowCallable) {
+        using Weight = typename Graph::EdgeType::ValueType::WeightType;
+        using IDType = typename Graph::IDType;
+
+        size_t n = graph.vertexCount();
+        Weight infinity = Graph::EdgeType::ValueType::maxWeight();
+        WeightedAdjacency<IDType, Weight> adjacency(graph, false);
+
+        std::vector<Weight> potential(n, Weight{0});
+        bool changed = true;
+        for (size_t round = 0; round < n && changed; ++round) {
+            changed = false;
+            for (size_t v = 0; v < n; ++v) {
+                for (size_t arc = adjacency.begin(v); arc < adjacency.end(v); ++arc) {
+                    Weight candidate = potential[v] + adjacency.weight(arc);
+                    if (candidate < potential[adjacency.target(arc)]) {
+                        potential[adjacency.target(arc)] = candidate;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        if (changed) {
+            return false;
+        }
+
+        std::vector<std::vector<Weight>> dist(pool.threadCount());
+        std::vector<IndexedDaryHeap<Weight>> queues(pool.threadCount(), IndexedDaryHeap<Weight>(n));
+        pool.parallelFor(0, n, [&](size_t source, size_t thread) {
+            std::vector<Weight>& row = dist[thread];
+            IndexedDaryHeap<Weight>& queue = queues[thread];
+            row.assign(n, infinity);
+
+            row[source] = Weight{0};
+            queue.push(source, row[source]);
+            while (!queue.empty()) {
+                size_t id = queue.top();
+                queue.pop();
+                for (size_t arc = adjacency.begin(id); arc < adjacency.end(id); ++arc) {
+                    size_t next = adjacency.target(arc);
+                    Weight candidate = row[id] + adjacency.weight(arc) + potential[id] - potential[next];
+                    if (candidate < row[next]) {
+                        row[next] = candidate;
+                        queue.pushOrDecrease(next, candidate);
+                    }
+                }
+            }
+
+            for (size_t v = 0; v < n; ++v) {
+                if (row[v] != infinity) {
+                    row[v] = row[v] - potential[source] + potential[v];
+                }
+            }
+            std::invoke(rowCallable, source, static_cast<const std::vector<Weight>&>(row));
+        }, 1);
+
+        return true;
+    }
+
+    template <GraphEdge Graph, IsVertex Vertex, typename Flow>
+    requires EdgeFlow<typename Graph::EdgeType> &&
+             GraphDirected<Graph> &&
+             GraphID<Graph> &&
+             std::same_as<typename Graph::VertexType, Vertex> &&
+             std::same_as<typename Graph::EdgeType::ValueType::FlowType, Flow>
+    Flow edmondsKarp(Graph& graph, Vertex& source, Vertex& target) {
+        using Edge = typename Graph::EdgeType;
+        Flow flow = Edge::ValueType::zeroFlow();
+
+        while (true) {
+            std::queue<Vertex *> queue = {};
+            queue.push(&source);
+            std::vector<Edge *> pred = {graph.vertexCount(), nullptr};
+
+            while (!queue.empty() && pred[target.flags.id] == nullptr) {
+                Vertex *ptr = queue.front();
+                queue.pop();
+
+                for (auto it = ptr->pairBegin(); it != ptr->pairEnd(); ++it) {
+                    Vertex &nv = *std::get<0>(*it);
+                    Edge &ne = *std::get<1>(*it);
                     if (pred[ne.to()] == nullptr && ne.to() != source.flags.id && ne.value.capacity() > ne.value.flow()) {
                         pred[ne.to()] = &ne;
                         queue.push(&nv);
@@ -345,6 +2258,643 @@ namespace sgl {
 
         return flow;
     }
+
+    // Dinic's algorithm: a breadth first search from source builds the level graph, then an
+    // iterative depth first search with per-vertex current-arc iterators saturates it with a
+    // blocking flow. Starts from the flows already on the edges; returns the flow added.
+    template <GraphEdge Graph>
+    requires EdgeFlow<typename Graph::EdgeType> &&
+             GraphDirected<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph>
+    typename Graph::EdgeType::ValueType::FlowType
+    dinic(Graph& graph, typename Graph::VertexType& source, typename Graph::VertexType& target) {
+        using Vertex = typename Graph::VertexType;
+        using Edge = typename Graph::EdgeType;
+        using Flow = typename Edge::ValueType::FlowType;
+
+        constexpr size_t NO_LEVEL = std::numeric_limits<size_t>::max();
+        size_t n = graph.vertexCount();
+        size_t sid = source.flags.id;
+        size_t tid = target.flags.id;
+        Flow flow = Edge::ValueType::zeroFlow();
+
+        std::vector<size_t> level(n);
+        std::vector<size_t> queue(n);
+        std::vector<typename Vertex::EdgeIterator> current(n);
+        std::vector<Edge*> path = {};
+        path.reserve(n);
+
+        auto residual = [](Edge& edge) { return edge.value.capacity() - edge.value.flow(); };
+
+        while (sid != tid) {
+            std::fill(level.begin(), level.end(), NO_LEVEL);
+            size_t head = 0;
+            size_t tail = 0;
+            level[sid] = 0;
+            queue[tail++] = sid;
+            while (head < tail && level[tid] == NO_LEVEL) {
+                size_t id = queue[head++];
+                for (auto it = graph[id].edgeBegin(); it != graph[id].edgeEnd(); ++it) {
+                    size_t next = it->to();
+                    if (level[next] == NO_LEVEL && residual(*it) > Edge::ValueType::zeroFlow()) {
+                        level[next] = level[id] + 1;
+                        queue[tail++] = next;
+                    }
+                }
+            }
+            if (level[tid] == NO_LEVEL) {
+                break;
+            }
+
+            for (size_t v = 0; v < n; ++v) {
+                current[v] = graph[v].edgeBegin();
+            }
+
+            size_t id = sid;
+            path.clear();
+            while (true) {
+                if (id == tid) {
+                    Flow augment = Edge::ValueType::maxFlow();
+                    for (Edge* edge: path) {
+                        augment = std::min(augment, residual(*edge));
+                    }
+                    size_t saturated = path.size();
+                    for (size_t i = path.size(); i > 0; --i) {
+                        Edge* edge = path[i - 1];
+                        edge->value.flow(edge->value.flow() + augment);
+                        edge->value.reverse()->value.flow(edge->value.reverse()->value.flow() - augment);
+                        if (residual(*edge) == Edge::ValueType::zeroFlow()) {
+                            saturated = i - 1;
+                        }
+                    }
+                    flow += augment;
+                    path.resize(saturated);
+                    id = path.empty() ? sid : path.back()->to();
+                    continue;
+                }
+
+                auto& arc = current[id];
+                while (arc != graph[id].edgeEnd() &&
+                       (residual(*arc) == Edge::ValueType::zeroFlow() || level[arc->to()] != level[id] + 1)) {
+                    ++arc;
+                }
+
+                if (arc != graph[id].edgeEnd()) {
+                    path.push_back(&(*arc));
+                    id = arc->to();
+                } else if (path.empty()) {
+                    break;
+                } else {
+                    level[id] = NO_LEVEL;
+                    id = path.back()->from();
+                    path.pop_back();
+                    ++current[id];
+                }
+            }
+        }
+
+        return flow;
+    }
+
+    // Highest-label push-relabel with the gap and global relabeling heuristics. The first phase
+    // discharges active vertices below height vertexCount, which yields a maximum preflow; the
+    // second returns the remaining excess to source, so the edges end up with a valid flow.
+    // Starts from the flows already on the edges; returns the flow added into target.
+    template <GraphEdge Graph>
+    requires EdgeFlow<typename Graph::EdgeType> &&
+             GraphDirected<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph>
+    typename Graph::EdgeType::ValueType::FlowType
+    pushRelabel(Graph& graph, typename Graph::VertexType& source, typename Graph::VertexType& target) {
+        using Vertex = typename Graph::VertexType;
+        using Edge = typename Graph::EdgeType;
+        using Flow = typename Edge::ValueType::FlowType;
+
+        size_t n = graph.vertexCount();
+        size_t sid = source.flags.id;
+        size_t tid = target.flags.id;
+        Flow zero = Edge::ValueType::zeroFlow();
+        if (sid == tid) {
+            return zero;
+        }
+
+        std::vector<Flow> excess(n, zero);
+        std::vector<size_t> height(n, 0);
+        std::vector<size_t> count(2 * n + 1, 0);
+        std::vector<std::vector<size_t>> active(2 * n + 1);
+        std::vector<size_t> queue(n);
+        std::vector<typename Vertex::EdgeIterator> current(n);
+        size_t highest = 0;
+        size_t relabels = 0;
+
+        auto residual = [](Edge& edge) { return edge.value.capacity() - edge.value.flow(); };
+
+        for (size_t v = 0; v < n; ++v) {
+            current[v] = graph[v].edgeBegin();
+            for (auto it = graph[v].edgeBegin(); it != graph[v].edgeEnd(); ++it) {
+                excess[v] -= it->value.flow();
+            }
+        }
+        Flow initial = excess[tid];
+
+        auto activate = [&active, &highest, &height](size_t id) {
+            active[height[id]].push_back(id);
+            highest = std::max(highest, height[id]);
+        };
+
+        auto push = [&excess, &residual](Edge& edge, Flow amount) {
+            edge.value.flow(edge.value.flow() + amount);
+            edge.value.reverse()->value.flow(edge.value.reverse()->value.flow() - amount);
+            excess[edge.from()] -= amount;
+            excess[edge.to()] += amount;
+        };
+
+        // Exact heights: distance to root in the residual graph, offset by base; vertices
+        // that cannot reach root get unreachable.
+        auto relabelFrom = [&](size_t root, size_t base, size_t unreachable) {
+            std::fill(height.begin(), height.end(), unreachable);
+            std::fill(count.begin(), count.end(), 0);
+            size_t head = 0;
+            size_t tail = 0;
+            height[root] = base;
+            queue[tail++] = root;
+            while (head < tail) {
+                size_t id = queue[head++];
+                for (auto it = graph[id].edgeBegin(); it != graph[id].edgeEnd(); ++it) {
+                    size_t next = it->to();
+                    if (height[next] == unreachable && next != sid && next != tid &&
+                        residual(*it->value.reverse()) > zero) {
+                        height[next] = height[id] + 1;
+                        queue[tail++] = next;
+                    }
+                }
+            }
+            height[sid] = std::max(height[sid], n);
+            for (size_t v = 0; v < n; ++v) {
+                current[v] = graph[v].edgeBegin();
+                ++count[height[v]];
+            }
+        };
+
+        auto globalRelabel = [&]() {
+            relabelFrom(tid, 0, n);
+            for (std::vector<size_t>& bucket: active) {
+                bucket.clear();
+            }
+            highest = 0;
+            for (size_t v = 0; v < n; ++v) {
+                if (v != sid && v != tid && excess[v] > zero && height[v] < n) {
+                    activate(v);
+                }
+            }
+            relabels = 0;
+        };
+
+        // Pushes the excess of id along admissible arcs, relabeling when they run out. In the
+        // first phase vertices reaching height n are left alone.
+        auto discharge = [&](size_t id, bool firstPhase) {
+            while (excess[id] > zero) {
+                auto& arc = current[id];
+                if (arc == graph[id].edgeEnd()) {
+                    size_t old = height[id];
+                    size_t lowest = 2 * n;
+                    for (auto it = graph[id].edgeBegin(); it != graph[id].edgeEnd(); ++it) {
+                        if (residual(*it) > zero) {
+                            lowest = std::min(lowest, height[it->to()] + 1);
+                        }
+                    }
+                    --count[old];
+                    height[id] = std::min(lowest, 2 * n);
+                    ++count[height[id]];
+                    arc = graph[id].edgeBegin();
+                    ++relabels;
+
+                    if (firstPhase && count[old] == 0 && old < n) {
+                        for (size_t v = 0; v < n; ++v) {
+                            if (height[v] > old && height[v] < n) {
+                                --count[height[v]];
+                                height[v] = n;
+                                ++count[n];
+                            }
+                        }
+                    }
+                    if (firstPhase && height[id] >= n) {
+                        return;
+                    }
+                    continue;
+                }
+
+                size_t next = arc->to();
+                if (residual(*arc) > zero && height[id] == height[next] + 1) {
+                    bool wasIdle = excess[next] == zero;
+                    push(*arc, std::min(excess[id], residual(*arc)));
+                    if (wasIdle && next != sid && next != tid && (!firstPhase || height[next] < n)) {
+                        activate(next);
+                    }
+                } else {
+                    ++arc;
+                }
+            }
+        };
+
+        height[sid] = n;
+        for (auto it = source.edgeBegin(); it != source.edgeEnd(); ++it) {
+            if (residual(*it) > zero) {
+                push(*it, residual(*it));
+            }
+        }
+        globalRelabel();
+
+        while (true) {
+            while (highest > 0 && active[highest].empty()) {
+                --highest;
+            }
+            if (active[highest].empty()) {
+                break;
+            }
+            size_t id = active[highest].back();
+            active[highest].pop_back();
+            if (height[id] != highest || excess[id] == zero) {
+                continue;
+            }
+
+            discharge(id, true);
+            if (relabels >= n) {
+                globalRelabel();
+            }
+        }
+
+        // Second phase: everything still holding excess is cut off from target.
+        relabelFrom(sid, n, 2 * n);
+        for (std::vector<size_t>& bucket: active) {
+            bucket.clear();
+        }
+        highest = 0;
+        for (size_t v = 0; v < n; ++v) {
+            if (v != sid && v != tid && excess[v] > zero) {
+                activate(v);
+            }
+        }
+        while (true) {
+            while (highest > 0 && active[highest].empty()) {
+                --highest;
+            }
+            if (active[highest].empty()) {
+                break;
+            }
+            size_t id = active[highest].back();
+            active[highest].pop_back();
+            if (height[id] == highest && excess[id] > zero) {
+                discharge(id, false);
+            }
+        }
+
+        return excess[tid] - initial;
+    }
+
+    // Applies (from, to, capacity) updates to the forward edges of a network that carries a
+    // maximum flow, as left by dinic(), edmondsKarp(), pushRelabel() or an earlier call, and
+    // repairs that flow locally (the first matching edge is updated when there are parallel
+    // ones). Where a new capacity falls below the edge's flow, the overflow is first rerouted
+    // from the edge's tail to its head through the residual graph; what cannot be rerouted is
+    // cancelled by sending it back from the tail to source and pulling it from target to the
+    // head. Any augmenting path left afterwards has to use an arc whose residual capacity grew,
+    // so only those arcs are tried: a breadth first search from the arc's tail back towards
+    // source and one from its head towards target, each stopping at its goal. Vertices a failed
+    // search reached are remembered until the next augmentation and not searched again. The
+    // work therefore follows the regions around the changed edges, though a change that moves
+    // the minimum cut far can still reach most of the network. Returns the total flow into
+    // target.
+    template <GraphEdge Graph, std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+    requires EdgeFlow<typename Graph::EdgeType> &&
+             GraphDirected<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::same_as<std::tuple<typename Graph::IDType, typename Graph::IDType,
+                                     typename Graph::EdgeType::ValueType::FlowType>, typename Iterator::value_type>
+    typename Graph::EdgeType::ValueType::FlowType
+    updateCapacities(Graph& graph, typename Graph::VertexType& source, typename Graph::VertexType& target,
+                     Iterator begin, Sentinel end, FlowRepairBuffers<typename Graph::EdgeType>& buffers) {
+        using Edge = typename Graph::EdgeType;
+        using Flow = typename Edge::ValueType::FlowType;
+
+        Flow zero = Edge::ValueType::zeroFlow();
+        size_t sid = source.flags.id;
+        size_t tid = target.flags.id;
+        buffers.resize(graph.vertexCount());
+        buffers.touched.clear();
+
+        auto residual = [](Edge& edge) { return edge.value.capacity() - edge.value.flow(); };
+
+        // Breadth first search over residual arcs from start until goal; forwardLink leads back.
+        // With remember set, a failed search marks everything it reached as unable to reach goal.
+        auto searchForward = [&](size_t start, size_t goal, bool remember) {
+            buffers.forwardSeen.reset();
+            buffers.forwardSeen.visit(start);
+            buffers.queue.clear();
+            buffers.queue.push_back(start);
+            for (size_t head = 0; head < buffers.queue.size(); ++head) {
+                size_t id = buffers.queue[head];
+                if (id == goal) {
+                    return true;
+                }
+                for (auto it = graph[id].edgeBegin(); it != graph[id].edgeEnd(); ++it) {
+                    size_t next = it->to();
+                    if (!buffers.forwardSeen.visited(next) && residual(*it) > zero &&
+                        !(remember && buffers.noTarget.visited(next))) {
+                        buffers.forwardSeen.visit(next);
+                        buffers.forwardLink[next] = &(*it);
+                        buffers.queue.push_back(next);
+                    }
+                }
+            }
+            if (remember) {
+                for (size_t id: buffers.queue) {
+                    buffers.noTarget.visit(id);
+                }
+            }
+            return false;
+        };
+
+        // The same against the arcs, from start back towards source; backwardLink leads forward.
+        auto searchBackward = [&](size_t start) {
+            buffers.backwardSeen.reset();
+            buffers.backwardSeen.visit(start);
+            buffers.queue.clear();
+            buffers.queue.push_back(start);
+            for (size_t head = 0; head < buffers.queue.size(); ++head) {
+                size_t id = buffers.queue[head];
+                if (id == sid) {
+                    return true;
+                }
+                for (auto it = graph[id].edgeBegin(); it != graph[id].edgeEnd(); ++it) {
+                    size_t previous = it->to();
+                    Edge* arc = it->value.reverse();
+                    if (!buffers.backwardSeen.visited(previous) && residual(*arc) > zero &&
+                        !buffers.noSource.visited(previous)) {
+                        buffers.backwardSeen.visit(previous);
+                        buffers.backwardLink[previous] = arc;
+                        buffers.queue.push_back(previous);
+                    }
+                }
+            }
+            for (size_t id: buffers.queue) {
+                buffers.noSource.visit(id);
+            }
+            return false;
+        };
+
+        // Appends the arcs of the last forward search from start to goal.
+        auto appendForward = [&](size_t start, size_t goal) {
+            size_t first = buffers.path.size();
+            for (size_t id = goal; id != start; id = buffers.forwardLink[id]->from()) {
+                buffers.path.push_back(buffers.forwardLink[id]);
+            }
+            std::reverse(buffers.path.begin() + static_cast<std::ptrdiff_t>(first), buffers.path.end());
+        };
+
+        // Sends up to limit along path; the reverse arcs gain residual capacity and every
+        // remembered failure may be outdated.
+        auto augment = [&](Flow limit) {
+            Flow amount = limit;
+            for (Edge* edge: buffers.path) {
+                amount = std::min(amount, residual(*edge));
+            }
+            for (Edge* edge: buffers.path) {
+                edge->value.flow(edge->value.flow() + amount);
+                edge->value.reverse()->value.flow(edge->value.reverse()->value.flow() - amount);
+                buffers.touched.push_back(edge->value.reverse());
+            }
+            buffers.noSource.reset();
+            buffers.noTarget.reset();
+            return amount;
+        };
+
+        // Sends up to limit from start to goal over residual paths; returns what could not be sent.
+        auto reroute = [&](size_t start, size_t goal, Flow limit) {
+            while (limit > zero && start != goal && searchForward(start, goal, false)) {
+                buffers.path.clear();
+                appendForward(start, goal);
+                limit -= augment(limit);
+            }
+            return start == goal ? zero : limit;
+        };
+
+        for (Iterator it = begin; it != end; ++it) {
+            auto [from, to, capacity] = *it;
+            Edge* edge = nullptr;
+            for (auto arc = graph[from].edgeBegin(); arc != graph[from].edgeEnd() && edge == nullptr; ++arc) {
+                if (arc->to() == to && !arc->value.isReverse()) {
+                    edge = &(*arc);
+                }
+            }
+            if (edge == nullptr) {
+                continue;
+            }
+
+            if (capacity > edge->value.capacity()) {
+                buffers.touched.push_back(edge);
+            }
+            edge->value.capacity(capacity);
+            if (edge->value.flow() <= capacity) {
+                continue;
+            }
+
+            Flow overflow = edge->value.flow() - capacity;
+            edge->value.flow(capacity);
+            edge->value.reverse()->value.flow(-capacity);
+
+            overflow = reroute(static_cast<size_t>(from), static_cast<size_t>(to), overflow);
+            if (static_cast<size_t>(from) != sid) {
+                reroute(static_cast<size_t>(from), sid, overflow);
+            }
+            if (static_cast<size_t>(to) != tid) {
+                reroute(tid, static_cast<size_t>(to), overflow);
+            }
+        }
+
+        while (!buffers.touched.empty()) {
+            Edge* edge = buffers.touched.back();
+            buffers.touched.pop_back();
+            size_t tail = edge->from();
+            size_t head = edge->to();
+            if (!(residual(*edge) > zero) || buffers.noSource.visited(tail) || buffers.noTarget.visited(head) ||
+                !searchBackward(tail) || !searchForward(head, tid, true)) {
+                continue;
+            }
+
+            buffers.path.clear();
+            for (size_t id = sid; id != tail; id = buffers.backwardLink[id]->to()) {
+                buffers.path.push_back(buffers.backwardLink[id]);
+            }
+            buffers.path.push_back(edge);
+            appendForward(head, tid);
+
+            // The two searches may cross; cutting out the loops leaves a simple path.
+            buffers.simplePath.clear();
+            buffers.onPath.reset();
+            buffers.onPath.visit(sid);
+            buffers.position[sid] = 0;
+            for (Edge* arc: buffers.path) {
+                size_t next = arc->to();
+                size_t at = buffers.position[next];
+                bool onPath = buffers.onPath.visited(next) && at <= buffers.simplePath.size() &&
+                              (at == 0 ? next == sid : static_cast<size_t>(buffers.simplePath[at - 1]->to()) == next);
+                if (onPath) {
+                    buffers.simplePath.resize(at);
+                } else {
+                    buffers.simplePath.push_back(arc);
+                    buffers.onPath.visit(next);
+                    buffers.position[next] = buffers.simplePath.size();
+                }
+            }
+            std::swap(buffers.path, buffers.simplePath);
+
+            augment(Edge::ValueType::maxFlow());
+            buffers.touched.push_back(edge);
+        }
+
+        Flow total = zero;
+        for (auto it = target.edgeBegin(); it != target.edgeEnd(); ++it) {
+            total -= it->value.flow();
+        }
+        return total;
+    }
+
+    // Convenience form that allocates its scratch space on every call; keep a
+    // FlowRepairBuffers per network to make repeated updates cheap.
+    template <GraphEdge Graph, std::forward_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+    requires EdgeFlow<typename Graph::EdgeType> &&
+             GraphDirected<Graph> &&
+             GraphID<Graph> &&
+             GraphRandomlyAccessible<Graph> &&
+             std::same_as<std::tuple<typename Graph::IDType, typename Graph::IDType,
+                                     typename Graph::EdgeType::ValueType::FlowType>, typename Iterator::value_type>
+    typename Graph::EdgeType::ValueType::FlowType
+    updateCapacities(Graph& graph, typename Graph::VertexType& source, typename Graph::VertexType& target,
+                     Iterator begin, Sentinel end) {
+        FlowRepairBuffers<typename Graph::EdgeType> buffers = {};
+        return updateCapacities(graph, source, target, begin, end, buffers);
+    }
+
+    // Hopcroft-Karp maximum bipartite matching. Each phase layers the left side with a breadth
+    // first search from the free left vertices, then augments along vertex-disjoint shortest
+    // paths found by an iterative depth first search with per-vertex current-arc iterators;
+    // O(E sqrt(V)) overall. Edges are read from the adjacency lists of the left vertices, and
+    // neighbours on the left side are ignored. Returns the matching size and every vertex's
+    // partner, or invalidID() for unmatched vertices.
+    template <GraphID Graph, typename LeftPredicate>
+    requires GraphRandomlyAccessible<Graph> &&
+             std::integral<typename Graph::IDType> &&
+             std::predicate<LeftPredicate, typename Graph::VertexType&>
+    std::pair<size_t, std::vector<typename Graph::IDType>> hopcroftKarp(Graph& graph, const LeftPredicate& isLeft) {
+        using Vertex = typename Graph::VertexType;
+        using IDType = typename Graph::IDType;
+
+        constexpr size_t NO_LAYER = std::numeric_limits<size_t>::max();
+        size_t n = graph.vertexCount();
+        std::vector<IDType> mate(n, invalidID<IDType>());
+        std::vector<IDType> left = {};
+        std::vector<bool> onLeft(n, false);
+        for (size_t i = 0; i < n; ++i) {
+            if (isLeft(graph[i])) {
+                left.push_back(static_cast<IDType>(i));
+                onLeft[i] = true;
+            }
+        }
+
+        std::vector<size_t> layer(n, NO_LAYER);
+        std::vector<IDType> queue(left.size());
+        std::vector<typename Vertex::VertexIterator> current(n);
+        std::vector<IDType> path = {};
+        size_t matched = 0;
+
+        while (true) {
+            size_t head = 0;
+            size_t tail = 0;
+            for (IDType u: left) {
+                layer[u] = mate[u] == invalidID<IDType>() ? 0 : NO_LAYER;
+                if (layer[u] == 0) {
+                    queue[tail++] = u;
+                }
+            }
+
+            size_t freeLayer = NO_LAYER;
+            while (head < tail) {
+                IDType u = queue[head++];
+                if (layer[u] >= freeLayer) {
+                    break;
+                }
+                for (auto it = graph[u].vertexBegin(); it != graph[u].vertexEnd(); ++it) {
+                    IDType v = it->flags.id;
+                    if (onLeft[v]) {
+                        continue;
+                    }
+                    IDType w = mate[v];
+                    if (w == invalidID<IDType>()) {
+                        freeLayer = std::min(freeLayer, layer[u] + 1);
+                    } else if (layer[w] == NO_LAYER) {
+                        layer[w] = layer[u] + 1;
+                        queue[tail++] = w;
+                    }
+                }
+            }
+            if (freeLayer == NO_LAYER) {
+                break;
+            }
+
+            for (IDType u: left) {
+                current[u] = graph[u].vertexBegin();
+            }
+
+            for (IDType root: left) {
+                if (mate[root] != invalidID<IDType>()) {
+                    continue;
+                }
+
+                path.assign(1, root);
+                while (!path.empty()) {
+                    IDType u = path.back();
+                    auto& arc = current[u];
+                    bool augmenting = false;
+                    for (; arc != graph[u].vertexEnd(); ++arc) {
+                        IDType v = arc->flags.id;
+                        if (onLeft[v]) {
+                            continue;
+                        }
+                        IDType w = mate[v];
+                        if (w == invalidID<IDType>() ? layer[u] + 1 == freeLayer : layer[w] == layer[u] + 1) {
+                            augmenting = w == invalidID<IDType>();
+                            break;
+                        }
+                    }
+
+                    if (augmenting) {
+                        for (IDType x: path) {
+                            IDType v = current[x]->flags.id;
+                            mate[x] = v;
+                            mate[v] = x;
+                            layer[x] = NO_LAYER;
+                        }
+                        ++matched;
+                        break;
+                    } else if (arc != graph[u].vertexEnd()) {
+                        path.push_back(mate[arc->flags.id]);
+                    } else {
+                        layer[u] = NO_LAYER;
+                        path.pop_back();
+                        if (!path.empty()) {
+                            ++current[path.back()];
+                        }
+                    }
+                }
+            }
+        }
+
+        return std::pair(matched, std::move(mate));
+    }
 }
 
 #endif